@@ -0,0 +1,42 @@
+#pragma once
+
+// Generated by Tools/pack_atlas.py from the PNGs in Source/ - do not edit.
+namespace AtlasIndex {
+
+    struct Region { int x, y, width, height; };
+
+    constexpr int version = 1;
+    constexpr int width = 1024;
+    constexpr int height = 758;
+
+    constexpr Region littleKnob {1, 1, 500, 500};
+    constexpr Region ralph {503, 1, 450, 220};
+    constexpr Region hole {1, 733, 584, 24};
+    constexpr Region bitCrush {550, 503, 300, 76};
+    constexpr Region downSample {248, 503, 300, 79};
+    constexpr Region glass {1, 503, 245, 185};
+    constexpr Region knobWithoutPointer {852, 503, 75, 75};
+    constexpr Region frequency {232, 690, 110, 39};
+    constexpr Region dryWet {78, 690, 109, 40};
+    constexpr Region amount {353, 690, 109, 33};
+    constexpr Region bits {1, 690, 75, 41};
+    constexpr Region hertz {929, 503, 75, 43};
+    constexpr Region screw {189, 690, 41, 40};
+    constexpr Region pointer {344, 690, 7, 38};
+    constexpr Region sin {464, 690, 34, 29};
+    constexpr Region fourFourK {713, 733, 32, 11};
+    constexpr Region pointOOne {747, 733, 27, 11};
+    constexpr Region fiveHundred {823, 733, 23, 10};
+    constexpr Region hundred {848, 733, 22, 10};
+    constexpr Region twentyFour {872, 733, 20, 10};
+    constexpr Region tenK {894, 733, 19, 10};
+    constexpr Region tri {587, 733, 21, 18};
+    constexpr Region quad {610, 733, 20, 17};
+    constexpr Region sawDown {632, 733, 20, 17};
+    constexpr Region sawUp {654, 733, 20, 17};
+    constexpr Region sh {676, 733, 20, 17};
+    constexpr Region sixty {776, 733, 16, 11};
+    constexpr Region four {794, 733, 14, 11};
+    constexpr Region zero {698, 733, 13, 15};
+    constexpr Region three {810, 733, 11, 11};
+}
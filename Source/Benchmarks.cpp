@@ -0,0 +1,236 @@
+// Performance benchmarks, compiled only when RALPH_BENCHMARKS=1 is added to the preprocessor definitions.
+// Run them through juce::UnitTestRunner::runTestsInCategory("Benchmarks"); results are written to the test log.
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "Parameters.h"
+
+#if RALPH_BENCHMARKS
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/resource.h>
+#endif
+
+namespace {
+    void setParameter(AudioProcessor& processor, const String& paramID, float value) {
+        for (auto* param : processor.getParameters())
+            if (auto* ranged = dynamic_cast<RangedAudioParameter*>(param))
+                if (ranged->paramID == paramID)
+                    ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+    }
+
+    void fillWithNoise(AudioBuffer<float>& buffer) {
+        Random random(1234);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int smp = 0; smp < buffer.getNumSamples(); ++smp)
+                buffer.setSample(ch, smp, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    // Peak resident set size of the process so far, in MB, or a negative value where it isn't available
+    double getPeakMemoryMB() {
+       #if JUCE_LINUX || JUCE_MAC
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        #if JUCE_MAC
+         return usage.ru_maxrss / (1024.0 * 1024.0);
+        #else
+         return usage.ru_maxrss / 1024.0;
+        #endif
+       #else
+        return -1.0;
+       #endif
+    }
+}
+
+class ProcessBlockBenchmark : public UnitTest {
+public:
+    ProcessBlockBenchmark() : UnitTest("processBlock per-sample cost", "Benchmarks") {}
+
+    void runTest() override {
+        beginTest("Block sizes 1 to 64, against 512");
+
+        constexpr int totalSamples = 1 << 20;
+        const int blockSizes[] = {1, 2, 4, 8, 16, 32, 64, 512};
+        double costAt16 = 0.0, costAt512 = 0.0;
+
+        for (auto blockSize : blockSizes) {
+            RalphAudioProcessor processor;
+            processor.setPlayConfigDetails(2, 2, 44100.0, blockSize);
+            processor.prepareToPlay(44100.0, blockSize);
+            setParameter(processor, Parameters::nameBitCrush, 8.0f);
+            setParameter(processor, Parameters::nameAmountBC, 2.0f);
+            setParameter(processor, Parameters::nameDownSample, 8000.0f);
+            setParameter(processor, Parameters::nameAmountDS, 2000.0f);
+            setParameter(processor, Parameters::nameDryWetBC, 70.0f);
+
+            AudioBuffer<float> buffer(2, blockSize);
+            MidiBuffer midi;
+            fillWithNoise(buffer);
+
+            const auto start = Time::getHighResolutionTicks();
+            for (int done = 0; done < totalSamples; done += blockSize)
+                processor.processBlock(buffer, midi);
+            const auto elapsed = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+            const auto nsPerSample = elapsed * 1.0e9 / totalSamples;
+            if (blockSize == 16) costAt16 = nsPerSample;
+            if (blockSize == 512) costAt512 = nsPerSample;
+
+            logMessage(String(blockSize).paddedLeft(' ', 4) + " samples: " + String(nsPerSample, 2) + " ns/sample");
+            expect(buffer.getMagnitude(0, blockSize) <= 2.0f);
+        }
+
+        // The small-block target: at 16 samples the per-sample cost stays within half again of the cost at 512
+        logMessage("16 against 512: " + String(costAt16 / costAt512, 2) + "x");
+        expectLessOrEqual(costAt16, 1.5 * costAt512, "per-sample cost at 16 samples is off the small-block target");
+    }
+};
+
+static ProcessBlockBenchmark processBlockBenchmark;
+
+class InstanceLoadBenchmark : public UnitTest {
+public:
+    InstanceLoadBenchmark() : UnitTest("Instance construction and prepare", "Benchmarks") {}
+
+    void runTest() override {
+        beginTest("1 to 1000 instances");
+
+        for (auto numInstances : {1, 10, 100, 500, 1000}) {
+            std::vector<std::unique_ptr<RalphAudioProcessor>> instances;
+            instances.reserve((size_t) numInstances);
+
+            const auto start = Time::getHighResolutionTicks();
+            for (int i = 0; i < numInstances; ++i)
+                instances.push_back(std::make_unique<RalphAudioProcessor>());
+            const auto constructed = Time::getHighResolutionTicks();
+
+            for (auto& instance : instances) {
+                instance->setPlayConfigDetails(2, 2, 48000.0, 512);
+                instance->prepareToPlay(48000.0, 512);
+            }
+            const auto prepared = Time::getHighResolutionTicks();
+
+            // The load target: 500 instances constructed and prepared well under a second
+            if (numInstances == 500)
+                expectLessOrEqual(Time::highResolutionTicksToSeconds(prepared - start), 1.0, "500 instances took a second or more to load");
+
+            const auto peakMemory = getPeakMemoryMB();
+            instances.clear();
+            const auto destroyed = Time::getHighResolutionTicks();
+
+            logMessage(String(numInstances).paddedLeft(' ', 5) + " instances:"
+                       + " construct " + String(Time::highResolutionTicksToSeconds(constructed - start) * 1000.0, 1) + " ms,"
+                       + " prepare " + String(Time::highResolutionTicksToSeconds(prepared - constructed) * 1000.0, 1) + " ms,"
+                       + " destroy " + String(Time::highResolutionTicksToSeconds(destroyed - prepared) * 1000.0, 1) + " ms,"
+                       + " peak memory " + (peakMemory < 0.0 ? String("n/a") : String(peakMemory, 1) + " MB"));
+        }
+    }
+};
+
+static InstanceLoadBenchmark instanceLoadBenchmark;
+
+class OversamplingBenchmark : public UnitTest {
+public:
+    OversamplingBenchmark() : UnitTest("BitCrush oversampling cost", "Benchmarks") {}
+
+    void runTest() override {
+        beginTest("Off, 2x, 4x, 8x");
+
+        constexpr int blockSize = 512;
+        constexpr int totalSamples = 1 << 20;
+        const char* factors[] = {"Off", "2x", "4x", "8x"};
+
+        for (int index = 0; index < 4; ++index) {
+            RalphAudioProcessor processor;
+            processor.setPlayConfigDetails(2, 2, 48000.0, blockSize);
+            setParameter(processor, Parameters::nameOversamplingBC, (float) index);
+            setParameter(processor, Parameters::nameBitCrush, 4.0f);
+            processor.prepareToPlay(48000.0, blockSize);
+
+            AudioBuffer<float> buffer(2, blockSize);
+            MidiBuffer midi;
+            fillWithNoise(buffer);
+
+            const auto start = Time::getHighResolutionTicks();
+            for (int done = 0; done < totalSamples; done += blockSize)
+                processor.processBlock(buffer, midi);
+            const auto elapsed = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+            logMessage(String(factors[index]).paddedLeft(' ', 3) + ": " + String(elapsed * 1.0e9 / totalSamples, 2) + " ns/sample, latency "
+                       + String(processor.getLatencySamples()) + " samples");
+        }
+    }
+};
+
+static OversamplingBenchmark oversamplingBenchmark;
+
+class EditorPaintBenchmark : public UnitTest {
+public:
+    EditorPaintBenchmark() : UnitTest("Editor construction and paint cost", "Benchmarks") {}
+
+    void runTest() override {
+        beginTest("Scales 0.25x to 2x, full, meter-only and slider-only repaints");
+
+        RalphAudioProcessor processor;
+
+        const auto start = Time::getHighResolutionTicks();
+        std::unique_ptr<AudioProcessorEditor> editor(processor.createEditor());
+        logMessage("construction: " + String(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0, 2) + " ms");
+
+        // Resizing the editor persists the size ratio, so put it back afterwards
+        const auto originalBounds = editor->getLocalBounds();
+
+        Array<Component*> meters, sliders;
+        collectChildren(*editor, meters, sliders);
+
+        for (auto scale : {0.25f, 0.5f, 0.75f, 1.0f, 1.5f, 2.0f}) {
+            editor->setSize(roundToInt(800 * scale), roundToInt(600 * scale));
+            Image frame(Image::ARGB, editor->getWidth(), editor->getHeight(), true, SoftwareImageType());
+
+            // The first frame builds the cached layers and isn't counted
+            renderFrame(*editor, frame, {});
+            const auto full = timeFrames(*editor, frame, {});
+            const auto meterOnly = timeFrames(*editor, frame, meters);
+            const auto sliderOnly = timeFrames(*editor, frame, sliders);
+
+            logMessage(String(scale, 2) + "x: full " + String(full, 3) + " ms, meters " + String(meterOnly, 3)
+                       + " ms, sliders " + String(sliderOnly, 3) + " ms per frame");
+        }
+
+        editor->setBounds(originalBounds);
+    }
+
+private:
+    static constexpr int numFrames = 50;
+
+    static void collectChildren(Component& parent, Array<Component*>& meters, Array<Component*>& sliders) {
+        for (auto* child : parent.getChildren()) {
+            if (dynamic_cast<Meter*>(child) != nullptr) meters.add(child);
+            else if (dynamic_cast<TimedSlider*>(child) != nullptr) sliders.add(child);
+            collectChildren(*child, meters, sliders);
+        }
+    }
+
+    // Paints the editor the way a repaint of the given components would: clipped to their areas, or everything
+    static void renderFrame(Component& editor, Image& frame, const Array<Component*>& dirty) {
+        Graphics g(frame);
+        if (!dirty.isEmpty()) {
+            RectangleList<int> region;
+            for (auto* component : dirty)
+                region.add(editor.getLocalArea(component, component->getLocalBounds()));
+            g.reduceClipRegion(region);
+        }
+        editor.paintEntireComponent(g, true);
+    }
+
+    static double timeFrames(Component& editor, Image& frame, const Array<Component*>& dirty) {
+        const auto start = Time::getHighResolutionTicks();
+        for (int i = 0; i < numFrames; ++i)
+            renderFrame(editor, frame, dirty);
+        return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000.0 / numFrames;
+    }
+};
+
+static EditorPaintBenchmark editorPaintBenchmark;
+
+#endif
@@ -1,29 +1,159 @@
 #include "BitCrush.h"
 
-BitCrush::BitCrush() : dryWet() {
-    dryWet.setMixingRule(dsp::DryWetMixingRule::sin3dB);
-}
+BitCrush::BitCrush() : dryWet() {}
 
 void BitCrush::prepare(const dsp::ProcessSpec& spec) {
-    dryWet.prepare(spec);
+    dryWet.prepare(spec.sampleRate);
+
+    for (int i = 0; i < maxOversamplingIndex; ++i) {
+        oversamplers[i] = std::make_unique<dsp::Oversampling<float>>(spec.numChannels, (size_t) (i + 1), dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+        oversamplers[i]->initProcessing(spec.maximumBlockSize);
+    }
+
+    dryDelay.setMaximumDelayInSamples(jmax(1, roundToInt(oversamplers[maxOversamplingIndex - 1]->getLatencyInSamples())));
+    dryDelay.prepare(spec);
+    dryBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+    fadeBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+    currentOversampling = -1;
+}
+
+int BitCrush::getLatencySamples() const {
+    // Latency follows the chosen factor only, so switching quality tiers never moves it
+    const auto index = targetOversampling.load();
+    if (index == 0 || oversamplers[index - 1] == nullptr) return 0;
+    return roundToInt(oversamplers[index - 1]->getLatencyInSamples());
+}
+
+int BitCrush::getMaxLatencySamples() const {
+    if (oversamplers[maxOversamplingIndex - 1] == nullptr) return 0;
+    return roundToInt(oversamplers[maxOversamplingIndex - 1]->getLatencyInSamples());
+}
+
+bool BitCrush::isDirect() const {
+    return currentOversampling == 0 && targetOversampling.load() == 0;
+}
+
+void BitCrush::setOversampling(int newIndex) {
+    targetOversampling.store(jlimit(0, maxOversamplingIndex, newIndex));
+}
+
+void BitCrush::setOversamplingAllowed(bool allowed) {
+    oversamplingAllowed.store(allowed);
 }
 
 void BitCrush::processBlock(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<double>& modulation) {
-    dsp::AudioBlock<float> audioBlock(buffer);
-    dryWet.pushDrySamples(audioBlock);
-    
-    const auto numSamples = buffer.getNumSamples();
-    const auto numCh = buffer.getNumChannels();
+    const auto target = targetOversampling.load();
+    const auto path = target == 0 ? Path::direct : (oversamplingAllowed.load() ? Path::oversampled : Path::delayed);
+
+    const auto previousOversampling = currentOversampling;
+    const auto previousPath = currentPath;
+    const bool switching = previousOversampling >= 0 && (path != previousPath || target != previousOversampling);
 
+    // The path only changes between blocks; a newly entered oversampler starts from clean filter state
+    if (target != currentOversampling) {
+        currentOversampling = target;
+        if (currentOversampling > 0)
+            dryDelay.setDelay(oversamplers[currentOversampling - 1]->getLatencyInSamples());
+    }
+    if (path == Path::oversampled && switching)
+        oversamplers[currentOversampling - 1]->reset();
+    currentPath = path;
+
+    const auto numSamples = buffer.getNumSamples();
     auto bufferData = buffer.getArrayOfWritePointers();
-    auto modData = modulation.getArrayOfWritePointers();
-    const auto numModCh = modulation.getNumChannels();
+    float dryGain, wetGain;
+
+    if (path == Path::direct && !switching) {
+        const auto numCh = buffer.getNumChannels();
+        auto modData = modulation.getArrayOfReadPointers();
+        const auto numModCh = modulation.getNumChannels();
+
+        for (int smp = 0; smp < numSamples; ++smp) {
+            dryWet.getNextGains(dryGain, wetGain);
+            for (int ch = 0; ch < numCh; ++ch) {
+                const float dry = bufferData[ch][smp];
+                const float wet = crush(dry, jmin(modData[jmin(ch, numModCh - 1)][smp], 24.0));
+                bufferData[ch][smp] = dry * dryGain + wet * wetGain;
+            }
+        }
+        return;
+    }
 
-    for (int smp = 0; smp < numSamples; ++smp)
+    const auto numCh = jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    // The dry signal is delayed by the current latency so every path mixes phase-aligned
+    for (int ch = 0; ch < numCh; ++ch) {
+        auto* dry = dryBuffer.getWritePointer(ch);
+        const auto* input = buffer.getReadPointer(ch);
+        if (currentOversampling == 0) {
+            FloatVectorOperations::copy(dry, input, numSamples);
+            continue;
+        }
+        for (int smp = 0; smp < numSamples; ++smp) {
+            dryDelay.pushSample(ch, input[smp]);
+            dry[smp] = dryDelay.popSample(ch);
+        }
+    }
+
+    // On a path change the old and new wet signals are crossfaded over one block instead of cutting
+    if (switching) {
+        for (int ch = 0; ch < numCh; ++ch)
+            fadeBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        renderWet(previousPath, previousOversampling, fadeBuffer, modulation, numCh, numSamples);
+    }
+
+    renderWet(path, currentOversampling, buffer, modulation, numCh, numSamples);
+
+    if (switching) {
+        const float step = 1.0f / (float) jmax(1, numSamples);
+        for (int ch = 0; ch < numCh; ++ch) {
+            const auto* previous = fadeBuffer.getReadPointer(ch);
+            for (int smp = 0; smp < numSamples; ++smp) {
+                const float fade = (float) smp * step;
+                bufferData[ch][smp] = previous[smp] + (bufferData[ch][smp] - previous[smp]) * fade;
+            }
+        }
+    }
+
+    for (int smp = 0; smp < numSamples; ++smp) {
+        dryWet.getNextGains(dryGain, wetGain);
         for (int ch = 0; ch < numCh; ++ch)
-            bufferData[ch][smp] = crush(bufferData[ch][smp], jmin(modData[jmin(ch, numModCh - 1)][smp], 24.0));
-    
-    dryWet.mixWetSamples(audioBlock);
+            bufferData[ch][smp] = dryBuffer.getSample(ch, smp) * dryGain + bufferData[ch][smp] * wetGain;
+    }
+}
+
+void BitCrush::renderWet(Path path, int oversamplingIndex, juce::AudioBuffer<float>& buffer, juce::AudioBuffer<double>& modulation, int numCh, int numSamples) {
+    auto modData = modulation.getArrayOfReadPointers();
+    const auto numModCh = modulation.getNumChannels();
+
+    if (path != Path::oversampled) {
+        // The delayed path crushes the already-delayed dry copy, lining up with the oversampled output
+        for (int ch = 0; ch < numCh; ++ch) {
+            auto* data = buffer.getWritePointer(ch);
+            if (path == Path::delayed)
+                FloatVectorOperations::copy(data, dryBuffer.getReadPointer(ch), numSamples);
+            const auto* bits = modData[jmin(ch, numModCh - 1)];
+            for (int smp = 0; smp < numSamples; ++smp)
+                data[smp] = crush(data[smp], jmin(bits[smp], 24.0));
+        }
+        return;
+    }
+
+    auto& oversampler = *oversamplers[oversamplingIndex - 1];
+    const auto factor = static_cast<int>(oversampler.getOversamplingFactor());
+
+    dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), (size_t) numCh, (size_t) numSamples);
+    auto oversampledBlock = oversampler.processSamplesUp(block);
+
+    // Bit depth is held for each host-rate sample across its oversampled sub-samples
+    for (int ch = 0; ch < numCh; ++ch) {
+        auto* data = oversampledBlock.getChannelPointer((size_t) ch);
+        const auto* bits = modData[jmin(ch, numModCh - 1)];
+        for (int smp = 0; smp < numSamples * factor; ++smp)
+            data[smp] = crush(data[smp], jmin(bits[smp / factor], 24.0));
+    }
+
+    oversampler.processSamplesDown(block);
 }
 
 float BitCrush::crush(float value, double bits) {
@@ -34,3 +164,16 @@ float BitCrush::crush(float value, double bits) {
 void BitCrush::setDryWet(float newValue) {
     dryWet.setWetMixProportion(newValue);
 }
+
+void BitCrush::setDryWetModulation(float offset) {
+    dryWet.setModulation(offset);
+}
+
+void BitCrush::setBypassed(bool shouldBeBypassed) {
+    dryWet.setBypassed(shouldBeBypassed);
+}
+
+bool BitCrush::isBypassed() const {
+    // With oversampling on the stage keeps running while bypassed, so its latency stays put
+    return dryWet.isFullyDry() && currentOversampling == 0;
+}
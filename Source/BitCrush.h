@@ -1,19 +1,57 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DryWetMix.h"
 
 class BitCrush {
 public:
+    static constexpr int maxOversamplingIndex = 3;
+
     BitCrush();
     ~BitCrush() {}
     
     void setDryWet(float newValue);
+    void setDryWetModulation(float offset);
+    void setBypassed(bool shouldBeBypassed);
+    bool isBypassed() const;
+    void setOversampling(int newIndex);
+    void setOversamplingAllowed(bool allowed);
+    int getLatencySamples() const;
+    int getMaxLatencySamples() const;
     void prepare(const dsp::ProcessSpec& spec);
     void processBlock (juce::AudioBuffer<float>& buffer, juce::AudioBuffer<double>& modulation);
+
+    // Per-sample access for a hold stage that only evaluates the crush on the samples it captures.
+    // Only valid on the direct path, where the crush has no state beyond its mix gains.
+    bool isDirect() const;
+    void getNextMixGains(float& dryGain, float& wetGain) { dryWet.getNextGains(dryGain, wetGain); }
+    float processSample(float dry, double bits, float dryGain, float wetGain) { return dry * dryGain + crush(dry, jmin(bits, 24.0)) * wetGain; }
+
+   #if JUCE_USE_SIMD
+    // Multiband kernel: one register holds one sample of every band, each lane with its own quantisation level
+    using BandVector = dsp::SIMDRegister<float>;
+    static BandVector crushBands(BandVector value, BandVector levels, BandVector inverseLevels) {
+        return BandVector::truncate(value * levels) * inverseLevels;
+    }
+   #endif
     
 private:
-    dsp::DryWetMixer<float> dryWet;
-    
+    // Direct runs at the host rate with no latency; Delayed is the host-rate crush padded to the
+    // oversampler's latency, used when the quality tier turns oversampling off
+    enum class Path { direct, delayed, oversampled };
+
+    DryWetMix dryWet;
+
+    // Oversamplers for 2x, 4x and 8x, all built in prepare so the factor can change on the audio thread
+    std::unique_ptr<dsp::Oversampling<float>> oversamplers[maxOversamplingIndex];
+    dsp::DelayLine<float, dsp::DelayLineInterpolationTypes::None> dryDelay;
+    AudioBuffer<float> dryBuffer, fadeBuffer;
+    std::atomic<int> targetOversampling { 0 };
+    std::atomic<bool> oversamplingAllowed { true };
+    int currentOversampling = 0;
+    Path currentPath = Path::direct;
+
+    void renderWet(Path path, int oversamplingIndex, juce::AudioBuffer<float>& buffer, juce::AudioBuffer<double>& modulation, int numCh, int numSamples);
     float crush(float value, double bits);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BitCrush)
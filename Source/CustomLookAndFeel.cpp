@@ -1,11 +1,6 @@
 #include "CustomLookAndFeel.h"
 
-CustomLookAndFeel::CustomLookAndFeel() {
-    littleKnob = juce::ImageFileFormat::loadFrom(BinaryData::littleKnob_png, BinaryData::littleKnob_pngSize);
-    holeImage = juce::ImageFileFormat::loadFrom(BinaryData::hole_png, BinaryData::hole_pngSize);
-    knobWithoutPointer = juce::ImageFileFormat::loadFrom(BinaryData::knobWithoutPointer_png, BinaryData::knobWithoutPointer_pngSize);
-    pointer = juce::ImageFileFormat::loadFrom(BinaryData::pointer_png, BinaryData::pointer_pngSize);
-}
+CustomLookAndFeel::CustomLookAndFeel() {}
 
 void CustomLookAndFeel::drawRotaryTicks(Graphics& g, float centreX, float centreY, float radius, float rotaryStartAngle, float rotaryEndAngle, int numTicks) {
     const float tickLength = 3.0f;
@@ -31,7 +26,7 @@ void CustomLookAndFeel::drawRotaryKnob(Graphics& g, int x, int y, int width, int
     const int offsetX = x + (width - reducedWidth) / 2;
     const int offsetY = y + (height - reducedHeight) / 2;
     
-    g.drawImageWithin(knobWithoutPointer, offsetX, offsetY, reducedWidth, reducedHeight, juce::RectanglePlacement::centred);
+    g.drawImageWithin(assets->knobWithoutPointer, offsetX, offsetY, reducedWidth, reducedHeight, juce::RectanglePlacement::centred);
 }
 
 void CustomLookAndFeel::drawRotaryPointer(Graphics& g, float rotation, int x, int y, int width, int height) {
@@ -48,7 +43,7 @@ void CustomLookAndFeel::drawRotaryPointer(Graphics& g, float rotation, int x, in
     g.saveState();
     g.addTransform(juce::AffineTransform::translation(offsetX + reducedWidth / 2, offsetY + reducedHeight / 2));
     g.addTransform(juce::AffineTransform::rotation(rotation));
-    g.drawImageWithin(pointer, -pointerWidth / 2, -reducedRadius, pointerWidth, pointerHeight, juce::RectanglePlacement::centred);
+    g.drawImageWithin(assets->pointer, -pointerWidth / 2, -reducedRadius, pointerWidth, pointerHeight, juce::RectanglePlacement::centred);
     g.restoreState();
 }
 
@@ -57,8 +52,10 @@ void CustomLookAndFeel::drawRotarySlider(Graphics& g, int x, int y, int width, i
     float centreX = x + width * 0.5f;
     float centreY = y + height * 0.5f;
 
-    drawRotaryTicks(g, centreX, centreY, radius, rotaryStartAngle, rotaryEndAngle, numTicks);
-    drawRotaryKnob(g, x, y, width, height);
+    drawCachedLayer(g, rotaryLayers, x + width, y + height, numTicks, rotaryStartAngle, rotaryEndAngle, [&](Graphics& layer) {
+        drawRotaryTicks(layer, centreX, centreY, radius, rotaryStartAngle, rotaryEndAngle, numTicks);
+        drawRotaryKnob(layer, x, y, width, height);
+    });
     
     const double rotation = rotaryStartAngle + sliderPosProportional * (rotaryEndAngle - rotaryStartAngle);
     drawRotaryPointer(g, rotation, x, y, width, height);
@@ -77,20 +74,19 @@ void CustomLookAndFeel::drawLinearTicks(Graphics& g, int x, int width) {
         float currentTickHeight = (i == 0 || i == 19) ? extendedTickHeight : tickHeight;
         g.drawLine(tickX, 0, tickX, currentTickHeight, 2.0f);
     }
-   
-    // Delimitare il contesto grafico in rosso
-    g.setColour(Colours::red);
-    //g.drawRect(static_cast<float>(x), 0.0f, static_cast<float>(width), extendedTickHeight, 2.0f);
 }
 
 void CustomLookAndFeel::drawLinearKnob(Graphics& g, float knobX) {
     g.setOpacity(1);
-    g.drawImageWithin(littleKnob, static_cast<int>(knobX), 5, 20, 20, RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->littleKnob, static_cast<int>(knobX), 5, 20, 20, RectanglePlacement::stretchToFit);
 }
 
 void CustomLookAndFeel::drawLinearSlider(Graphics &g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, Slider::SliderStyle sliderStyle, Slider &slider) {
-    g.setOpacity(0.5);
-    g.drawImageWithin(holeImage, x + 2, y + 11, width - 4, 7, juce::RectanglePlacement::stretchToFit);
+    drawCachedLayer(g, linearLayers, x + width, y + height, 0, 0.0f, 0.0f, [&](Graphics& layer) {
+        layer.setOpacity(0.5);
+        layer.drawImageWithin(assets->holeImage, x + 2, y + 11, width - 4, 7, juce::RectanglePlacement::stretchToFit);
+        drawLinearTicks(layer, x, width);
+    });
 
     maxSliderPos = 188;
     float proportion = (sliderPos - minSliderPos) / (maxSliderPos - minSliderPos);
@@ -99,20 +95,15 @@ void CustomLookAndFeel::drawLinearSlider(Graphics &g, int x, int y, int width, i
     // Limita knobX entro i limiti del contesto grafico
     knobX = jlimit(static_cast<float>(x), static_cast<float>(x + width - 20), knobX);
 
-    drawLinearTicks(g, x, width);
     drawLinearKnob(g, knobX);
 
     drawTimedSliderOverlay(g, slider, width, height);
-
-    // Rettangolo di debug
 }
 
 
-
 void CustomLookAndFeel::drawTimedSliderOverlay(Graphics& g, Slider& slider, int width, int height) {
     if (auto* timedSlider = dynamic_cast<TimedSlider*>(&slider)) {
         
-        timedSlider->setValueWithTimeCheck(slider.getValue());
         if (!timedSlider->isDrawable()) return;
         
         String sliderValue = String(timedSlider->getValue());
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "TimedSlider.h"
+#include "SharedAssets.h"
 
 class CustomLookAndFeel : public LookAndFeel_V4 {
 public:
@@ -13,20 +14,55 @@ public:
     void setNumTicks(int numTicks) { this->numTicks = numTicks; }
 
 private:
-    Image littleKnob;
-    Image holeImage;
-    Image knobWithoutPointer;
-    Image pointer;
+    SharedResourcePointer<SharedAssets> assets;
 
     int numTicks = 15;
 
+    // Static parts of a slider (ticks, knob body, track) rendered once per size, scale, tick count and rotary range
+    struct CachedLayer {
+        int width, height;
+        float scale;
+        int numTicks;
+        float startAngle, endAngle;
+        Image image;
+    };
+
+    static constexpr size_t maxCachedLayers = 8;
+    std::vector<CachedLayer> rotaryLayers, linearLayers;
+
     void drawRotaryTicks(Graphics& g, float centreX, float centreY, float radius, float rotaryStartAngle, float rotaryEndAngle, int numTicks);
     void drawRotaryKnob(Graphics& g, int x, int y, int width, int height);
     void drawRotaryPointer(Graphics& g, float rotation, int x, int y, int width, int height);
     void drawLinearTicks(Graphics& g, int x, int width);
     void drawLinearKnob(Graphics& g, float knobX);
+    template <typename Render>
+    void drawCachedLayer(Graphics& g, std::vector<CachedLayer>& layers, int width, int height, int ticks, float startAngle, float endAngle, Render&& render);
     void drawTimedSliderOverlay(Graphics& g, Slider& slider, int width, int height);
 
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CustomLookAndFeel)
 };
+
+template <typename Render>
+void CustomLookAndFeel::drawCachedLayer(Graphics& g, std::vector<CachedLayer>& layers, int width, int height, int ticks, float startAngle, float endAngle, Render&& render) {
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    auto layer = std::find_if(layers.begin(), layers.end(), [&](const CachedLayer& cached) {
+        return cached.width == width && cached.height == height && cached.scale == scale && cached.numTicks == ticks
+            && cached.startAngle == startAngle && cached.endAngle == endAngle;
+    });
+
+    if (layer == layers.end()) {
+        if (layers.size() >= maxCachedLayers) layers.erase(layers.begin());
+
+        Image image(Image::ARGB, jmax(1, roundToInt(width * scale)), jmax(1, roundToInt(height * scale)), true);
+        Graphics layerGraphics(image);
+        layerGraphics.addTransform(AffineTransform::scale(scale));
+        render(layerGraphics);
+
+        layers.push_back({width, height, scale, ticks, startAngle, endAngle, image});
+        layer = std::prev(layers.end());
+    }
+
+    g.setOpacity(1);
+    g.drawImageTransformed(layer->image, AffineTransform::scale(1.0f / scale));
+}
@@ -0,0 +1,131 @@
+#include "DecimatedDomain.h"
+
+void DecimatedDomain::prepare(double hostSampleRate, int maximumBlockSize, int numChannels) {
+    factor = 1;
+    while (factor < maxFactor && hostSampleRate / (factor * 2) >= 44100.0)
+        factor *= 2;
+
+    internalSampleRate = hostSampleRate / factor;
+    phase = 0;
+    lastFirstKept = 0;
+    engaged = false;
+    filtering = false;
+    bandLimiting.reset(hostSampleRate, 0.01);
+    bandLimiting.setCurrentAndTargetValue(0.0f);
+
+    antiAliasing.clear();
+    reconstruction.clear();
+    numSections = 0;
+    if (factor == 1) return;
+
+    // Elliptic low-pass, flat to 0.42 of the internal rate and 80 dB down at its Nyquist frequency
+    auto coefficients = dsp::FilterDesign<float>::designIIRLowpassHighOrderEllipticMethod(0.42f * (float) internalSampleRate, hostSampleRate, 0.08f / (float) factor, -0.1f, -80.0f);
+    numSections = coefficients.size();
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (auto* section : coefficients) {
+            antiAliasing.emplace_back(section);
+            reconstruction.emplace_back(section);
+        }
+    }
+
+    const dsp::ProcessSpec monoSpec {hostSampleRate, (uint32) maximumBlockSize, 1};
+    for (auto& filter : antiAliasing) filter.prepare(monoSpec);
+    for (auto& filter : reconstruction) filter.prepare(monoSpec);
+
+    filtered.setSize(numChannels, maximumBlockSize);
+    internal.setSize(numChannels, maximumBlockSize / factor + 1);
+    scratch.setSize(numChannels, maximumBlockSize);
+}
+
+void DecimatedDomain::runSections(std::vector<dsp::IIR::Filter<float>>& filters, AudioBuffer<float>& buffer, int channel, int numSamples) {
+    float* channelData[] = { buffer.getWritePointer(channel) };
+    dsp::AudioBlock<float> block(channelData, 1, (size_t) numSamples);
+    dsp::ProcessContextReplacing<float> context(block);
+    for (int section = 0; section < numSections; ++section)
+        filters[(size_t) (channel * numSections + section)].process(context);
+}
+
+bool DecimatedDomain::beginBlock(const AudioBuffer<float>& input, bool wantsDecimation) {
+    if (!isAvailable()) return false;
+
+    bandLimiting.setTargetValue(wantsDecimation ? 1.0f : 0.0f);
+
+    // The filters only run while the domain is engaged or fading; a restart begins from clean state,
+    // and the fade-in gives them time to settle before the domain engages
+    const bool wasFiltering = filtering;
+    filtering = wantsDecimation || engaged || bandLimiting.isSmoothing() || bandLimiting.getCurrentValue() > 0.0f;
+    if (!filtering) return false;
+    if (!wasFiltering) {
+        for (auto& filter : antiAliasing) filter.reset();
+        for (auto& filter : reconstruction) filter.reset();
+    }
+
+    blockSize = input.getNumSamples();
+    blockChannels = jmin(input.getNumChannels(), filtered.getNumChannels());
+    for (int ch = 0; ch < blockChannels; ++ch) {
+        filtered.copyFrom(ch, 0, input, ch, 0, blockSize);
+        runSections(antiAliasing, filtered, ch, blockSize);
+    }
+
+    if (!wantsDecimation) {
+        engaged = false;
+    } else if (!engaged && !bandLimiting.isSmoothing() && bandLimiting.getCurrentValue() == 1.0f) {
+        engaged = true;
+        phase = 0;
+    }
+    return engaged;
+}
+
+AudioBuffer<float>& DecimatedDomain::decimate(int& firstKept) {
+    firstKept = lastFirstKept = phase;
+    const int numInternal = blockSize > phase ? (blockSize - phase + factor - 1) / factor : 0;
+    phase = phase + numInternal * factor - blockSize;
+
+    for (int ch = 0; ch < blockChannels; ++ch) {
+        const auto* source = filtered.getReadPointer(ch);
+        auto* kept = internal.getWritePointer(ch);
+        for (int i = 0; i < numInternal; ++i)
+            kept[i] = source[firstKept + i * factor];
+    }
+
+    internalView.setDataToReferTo(internal.getArrayOfWritePointers(), blockChannels, numInternal);
+    return internalView;
+}
+
+void DecimatedDomain::endBlock(AudioBuffer<float>& output) {
+    if (!isAvailable() || !filtering) return;
+
+    const auto numSamples = output.getNumSamples();
+    const auto numCh = jmin(output.getNumChannels(), scratch.getNumChannels());
+
+    if (engaged) {
+        // Zero-stuffing spreads each sample's energy over factor host samples, hence the gain
+        const auto numInternal = internalView.getNumSamples();
+        for (int ch = 0; ch < numCh; ++ch) {
+            auto* stuffed = scratch.getWritePointer(ch);
+            FloatVectorOperations::clear(stuffed, numSamples);
+            const auto* processed = internalView.getReadPointer(ch);
+            for (int i = 0; i < numInternal; ++i)
+                stuffed[lastFirstKept + i * factor] = processed[i] * (float) factor;
+
+            runSections(reconstruction, scratch, ch, numSamples);
+            output.copyFrom(ch, 0, scratch, ch, 0, numSamples);
+        }
+        return;
+    }
+
+    // While fading at the host rate the reconstruction filter runs on the output itself, which warms it up
+    // and provides the band-limited copy the fade moves towards
+    for (int ch = 0; ch < numCh; ++ch) {
+        scratch.copyFrom(ch, 0, output, ch, 0, numSamples);
+        runSections(reconstruction, scratch, ch, numSamples);
+    }
+
+    auto outputData = output.getArrayOfWritePointers();
+    for (int smp = 0; smp < numSamples; ++smp) {
+        const auto amount = bandLimiting.getNextValue();
+        for (int ch = 0; ch < numCh; ++ch)
+            outputData[ch][smp] += (scratch.getSample(ch, smp) - outputData[ch][smp]) * amount;
+    }
+}
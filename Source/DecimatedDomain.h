@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Reduced-rate domain for high host rates. At 88.2 kHz and up the chain can run at host rate / 2 or / 4
+// (never below 44.1 kHz): the input is low-passed and decimated on the way in, and zero-stuffed and
+// low-passed again on the way out. It only engages while the processor asks for it, i.e. while the hold
+// rate sits below the internal Nyquist frequency; everything else stays at the host rate, unfiltered.
+// The filters only run while the domain is engaged or fading: the host-rate output is faded onto its
+// band-limited copy before entering and back after leaving, so neither switch clicks.
+class DecimatedDomain {
+public:
+    static constexpr int maxFactor = 4;
+
+    DecimatedDomain() = default;
+    ~DecimatedDomain() = default;
+
+    void prepare(double hostSampleRate, int maximumBlockSize, int numChannels);
+
+    bool isAvailable() const { return factor > 1; }
+    int getFactor() const { return factor; }
+    double getInternalSampleRate() const { return internalSampleRate; }
+
+    // Filters the host block and returns whether this block runs decimated. Entering waits until the
+    // band-limiting fade has completed; leaving takes effect right away and fades out afterwards.
+    bool beginBlock(const AudioBuffer<float>& input, bool wantsDecimation);
+
+    // Decimated blocks only: a view of the internal-rate samples. firstKept is the index of the host
+    // sample the first internal sample stands for.
+    AudioBuffer<float>& decimate(int& firstKept);
+
+    // Brings a decimated block back to the host rate, or applies the band-limiting fade to a host-rate one
+    void endBlock(AudioBuffer<float>& output);
+
+private:
+    int factor = 1;
+    int phase = 0;
+    int lastFirstKept = 0;
+    double internalSampleRate = 44100.0;
+    int numSections = 0;
+    int blockSize = 0;
+    int blockChannels = 0;
+    bool engaged = false;
+    bool filtering = false;
+
+    // 0 leaves the host-rate output untouched, 1 replaces it with its band-limited copy
+    SmoothedValue<float, ValueSmoothingTypes::Linear> bandLimiting;
+
+    AudioBuffer<float> filtered, internal, internalView, scratch;
+    std::vector<dsp::IIR::Filter<float>> antiAliasing, reconstruction;
+
+    void runSections(std::vector<dsp::IIR::Filter<float>>& filters, AudioBuffer<float>& buffer, int channel, int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecimatedDomain)
+};
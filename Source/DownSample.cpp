@@ -2,51 +2,106 @@
 #include "DownSample.h"
 
 DownSample::DownSample()
-    : currentSampleRate(44100.0) 
+    : currentReferenceRate(44100.0) 
 {
-    dryWet.setMixingRule(dsp::DryWetMixingRule::sin3dB);
 }
 
-void DownSample::prepareToPlay(double sampleRate, int samplesPerBlock, const dsp::ProcessSpec& spec) {
-    currentSampleRate = sampleRate;
-    aliasingBuffer.setSize(2, samplesPerBlock);
-    aliasingBuffer.clear();
-    ratio = currentSampleRate;
-    dryWet.prepare(spec);
-    for (int i = 0; i < spec.numChannels; i++) previousValue.push_back(0);
-}
-
-void DownSample::releaseResources() {
-    aliasingBuffer.setSize(0, 0);
-    
+void DownSample::prepareToPlay(double sampleRate, double referenceRate) {
+    currentReferenceRate = referenceRate;
+    dryWet.prepare(sampleRate);
+    sampleCounter = 0;
+    step = 1;
+    lastValue[0] = lastValue[1] = 0.0f;
 }
 
 void DownSample::processBlock(AudioBuffer<float>& buffer, AudioBuffer<double>& modulation) {
-    dsp::AudioBlock<float> audioBlock(buffer);
-    dryWet.pushDrySamples(audioBlock);
-    
     int numSamples = buffer.getNumSamples();
-    int numChannels = buffer.getNumChannels();
+    int numChannels = jmin(buffer.getNumChannels(), 2);
     auto bufferData = buffer.getArrayOfWritePointers();
-    auto modData = modulation.getArrayOfWritePointers();
+    auto modData = modulation.getArrayOfReadPointers();
     
-    int sampleCounter = 0;
+    // The hold counter lives across calls, so hosts that split blocks (down to a single sample) still hold correctly
     int ratio;
     double targetSampleRate;
+    float dryGain, wetGain;
     
     for (int smp = 0; smp < numSamples; ++smp) {
-        targetSampleRate = jmin(modData[0][smp], currentSampleRate);
-        ratio = static_cast<int>(currentSampleRate / targetSampleRate);
+        targetSampleRate = jmin(modData[0][smp], currentReferenceRate);
+        ratio = jmax(1, static_cast<int>(currentReferenceRate / targetSampleRate));
+        const bool capture = advanceCounter(ratio);
+        dryWet.getNextGains(dryGain, wetGain);
         
-        for (int ch = 0; ch < numChannels; ++ch)
-            bufferData[ch][smp] = (sampleCounter) ? lastValue[ch] : (lastValue[ch] = bufferData[ch][smp]);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const float dry = bufferData[ch][smp];
+            if (capture) lastValue[ch] = dry;
+            bufferData[ch][smp] = dry * dryGain + lastValue[ch] * wetGain;
+        }
 
-        ++sampleCounter %= ratio;
     }
-    
-    dryWet.mixWetSamples(audioBlock);
+}
+
+// BitCrush feeding straight into a fully wet hold: every sample between captures is discarded, so the crush
+// is only evaluated on captured samples. Its mix gains still advance every sample, keeping the output identical.
+void DownSample::processCrushed(AudioBuffer<float>& buffer, AudioBuffer<double>& modulation, BitCrush& crush, AudioBuffer<double>& crushModulation) {
+    int numSamples = buffer.getNumSamples();
+    int numChannels = jmin(buffer.getNumChannels(), 2);
+    auto bufferData = buffer.getArrayOfWritePointers();
+    auto modData = modulation.getArrayOfReadPointers();
+    auto crushModData = crushModulation.getArrayOfReadPointers();
+    const auto numCrushModCh = crushModulation.getNumChannels();
+
+    int ratio;
+    double targetSampleRate;
+    float dryGain, wetGain, crushDryGain, crushWetGain;
+
+    for (int smp = 0; smp < numSamples; ++smp) {
+        targetSampleRate = jmin(modData[0][smp], currentReferenceRate);
+        ratio = jmax(1, static_cast<int>(currentReferenceRate / targetSampleRate));
+        const bool capture = advanceCounter(ratio);
+        dryWet.getNextGains(dryGain, wetGain);
+        crush.getNextMixGains(crushDryGain, crushWetGain);
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            if (capture)
+                lastValue[ch] = crush.processSample(bufferData[ch][smp], crushModData[jmin(ch, numCrushModCh - 1)][smp], crushDryGain, crushWetGain);
+            bufferData[ch][smp] = lastValue[ch] * wetGain;
+        }
+
+    }
+}
+
+void DownSample::setDecimationFactor(int factor) {
+    step = jmax(1, factor);
+}
+
+// The counter runs in host samples, so the hold ratio is the same whether or not the chain is decimated.
+// Returns whether a capture point falls among the host samples the current sample stands for.
+bool DownSample::advanceCounter(int ratio) {
+    const bool capture = sampleCounter == 0 || (sampleCounter < ratio && sampleCounter + step > ratio);
+    sampleCounter = (sampleCounter + step) % ratio;
+    return capture;
 }
 
 void DownSample::setDryWet(float newValue) {
     dryWet.setWetMixProportion(newValue);
 }
+
+void DownSample::setDryWetModulation(float offset) {
+    dryWet.setModulation(offset);
+}
+
+void DownSample::setBypassed(bool shouldBeBypassed) {
+    dryWet.setBypassed(shouldBeBypassed);
+}
+
+bool DownSample::isBypassed() const {
+    return dryWet.isFullyDry();
+}
+
+bool DownSample::isFullyWet() const {
+    return dryWet.isFullyWet();
+}
+
+void DownSample::copyChannelState(int source, int destination) {
+    lastValue[destination] = lastValue[source];
+}
@@ -1,25 +1,52 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DryWetMix.h"
+#include "BitCrush.h"
 
 class DownSample {
 public:
     DownSample();
     ~DownSample() {}
     
-    void prepareToPlay(double sampleRate, int samplesPerBlock, const dsp::ProcessSpec& spec);
-    void releaseResources();
+    // DS values are relative to the host rate: referenceRate is the DS value that holds nothing at this rate
+    void prepareToPlay(double sampleRate, double referenceRate);
+    // Host samples per processed sample, while the chain runs in the decimated domain
+    void setDecimationFactor(int factor);
     void processBlock(AudioBuffer<float>& buffer, AudioBuffer<double>& modulation);
+    void processCrushed(AudioBuffer<float>& buffer, AudioBuffer<double>& modulation, BitCrush& crush, AudioBuffer<double>& crushModulation);
     void setDryWet(float newValue);
+    void setDryWetModulation(float offset);
+    void setBypassed(bool shouldBeBypassed);
+    bool isBypassed() const;
+    bool isFullyWet() const;
+    void copyChannelState(int source, int destination);
+
+   #if JUCE_USE_SIMD
+    // Multiband kernels: every lane holds one band with its own counter and ratio. Lanes whose counter
+    // is at zero capture the new value, the others keep holding; counters wrap when they reach their ratio.
+    using BandVector = dsp::SIMDRegister<float>;
+    static BandVector::vMaskType captureMask(BandVector counters) {
+        return BandVector::equal(counters, BandVector::expand(0.0f));
+    }
+    static void holdBands(BandVector& held, BandVector value, BandVector::vMaskType capture) {
+        held += (value - held) & capture;
+    }
+    static void advanceBandCounters(BandVector& counters, BandVector ratios) {
+        counters += BandVector::expand(1.0f);
+        counters = counters & BandVector::lessThan(counters, ratios);
+    }
+   #endif
     
 private:
-    AudioBuffer<float> aliasingBuffer;
-    dsp::DryWetMixer<float> dryWet;
-    std::vector<float> previousValue;
+    DryWetMix dryWet;
 
     float lastValue[2] = {0.0f, 0.0f};
-    double currentSampleRate;
-    int ratio;
+    double currentReferenceRate;
+    int sampleCounter = 0;
+    int step = 1;
+
+    bool advanceCounter(int ratio);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DownSample)
 };
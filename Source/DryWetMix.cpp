@@ -0,0 +1,50 @@
+#include "DryWetMix.h"
+
+DryWetMix::DryWetMix() : dryGain(0.0f), wetGain(1.0f) {}
+
+void DryWetMix::prepare(double sampleRate) {
+    dryGain.reset(sampleRate, 0.05);
+    wetGain.reset(sampleRate, 0.05);
+
+    // Starts on the current mix rather than ramping to it
+    updateTargets();
+    dryGain.setCurrentAndTargetValue(dryGain.getTargetValue());
+    wetGain.setCurrentAndTargetValue(wetGain.getTargetValue());
+}
+
+void DryWetMix::setWetMixProportion(float newValue) {
+    proportion.store(jlimit(0.0f, 1.0f, newValue));
+}
+
+void DryWetMix::setBypassed(bool shouldBeBypassed) {
+    // Bypass ramps to fully dry like any other mix change, keeping the user's proportion for later
+    bypassed.store(shouldBeBypassed);
+}
+
+void DryWetMix::setModulation(float offset) {
+    // The gain smoothing turns the per-block steps into ramps
+    modulation = offset;
+    updateTargets();
+}
+
+void DryWetMix::updateTargets() {
+    const auto effective = bypassed.load() ? 0.0f : jlimit(0.0f, 1.0f, proportion.load() + modulation);
+    if (effective == currentEffective) return;
+
+    currentEffective = effective;
+    dryGain.setTargetValue(std::sin(MathConstants<float>::halfPi * (1.0f - effective)));
+    wetGain.setTargetValue(std::sin(MathConstants<float>::halfPi * effective));
+}
+
+void DryWetMix::getNextGains(float& dry, float& wet) {
+    dry = dryGain.getNextValue();
+    wet = wetGain.getNextValue();
+}
+
+bool DryWetMix::isFullyDry() const {
+    return !wetGain.isSmoothing() && wetGain.getTargetValue() == 0.0f;
+}
+
+bool DryWetMix::isFullyWet() const {
+    return !dryGain.isSmoothing() && dryGain.getTargetValue() == 0.0f;
+}
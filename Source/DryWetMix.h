@@ -0,0 +1,37 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Equal-power (sin3dB) dry/wet gains that a stage applies inline, in the same loop that computes its wet signal
+class DryWetMix {
+public:
+    DryWetMix();
+    ~DryWetMix() = default;
+
+    void prepare(double sampleRate);
+
+    // Any thread: only stored here, picked up by the next setModulation() call
+    void setWetMixProportion(float newValue);
+    void setBypassed(bool shouldBeBypassed);
+
+    // Audio thread, once per block before the gains are read: the only place the gain targets are set
+    void setModulation(float offset);
+    void getNextGains(float& dry, float& wet);
+
+    // True once the gains have settled on an all-dry or all-wet mix, so callers can skip work
+    bool isFullyDry() const;
+    bool isFullyWet() const;
+
+private:
+    std::atomic<float> proportion { 1.0f };
+    std::atomic<bool> bypassed { false };
+    float modulation = 0.0f;
+    float currentEffective = 1.0f;
+
+    SmoothedValue<float, ValueSmoothingTypes::Linear> dryGain;
+    SmoothedValue<float, ValueSmoothingTypes::Linear> wetGain;
+
+    void updateTargets();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DryWetMix)
+};
@@ -0,0 +1,102 @@
+#include "EnvelopeFollower.h"
+
+namespace {
+    void measureChannel(const float* data, int numSamples, float& peak, float& sumOfSquares) {
+        int smp = 0;
+
+       #if JUCE_USE_SIMD
+        using Vector = dsp::SIMDRegister<float>;
+        constexpr int vectorSize = static_cast<int>(Vector::SIMDNumElements);
+
+        for (; smp < numSamples && !Vector::isSIMDAligned(data + smp); ++smp) {
+            peak = jmax(peak, std::abs(data[smp]));
+            sumOfSquares += data[smp] * data[smp];
+        }
+
+        auto vectorPeak = Vector::expand(0.0f);
+        auto vectorSum = Vector::expand(0.0f);
+
+        for (; smp + vectorSize <= numSamples; smp += vectorSize) {
+            const auto value = Vector::fromRawArray(data + smp);
+            vectorPeak = Vector::max(vectorPeak, Vector::abs(value));
+            vectorSum += value * value;
+        }
+
+        for (size_t i = 0; i < Vector::SIMDNumElements; ++i)
+            peak = jmax(peak, vectorPeak.get(i));
+        sumOfSquares += vectorSum.sum();
+       #endif
+
+        for (; smp < numSamples; ++smp) {
+            peak = jmax(peak, std::abs(data[smp]));
+            sumOfSquares += data[smp] * data[smp];
+        }
+    }
+}
+
+void EnvelopeFollower::prepare(double newSampleRate) {
+    sampleRate = newSampleRate;
+    cachedAttackMs = cachedReleaseMs = -1.0f;
+    chunkPeak = chunkSumOfSquares = 0.0f;
+    chunkPosition = 0;
+    envelope = value = step = 0.0;
+}
+
+void EnvelopeFollower::updateCoefficients() {
+    const auto attack = attackMs.load();
+    const auto release = releaseMs.load();
+    if (attack == cachedAttackMs && release == cachedReleaseMs) return;
+
+    // One-pole coefficients per control tick, not per sample
+    cachedAttackMs = attack;
+    cachedReleaseMs = release;
+    attackCoefficient = std::exp(-controlInterval / (jmax(0.01f, attack) * 0.001 * sampleRate));
+    releaseCoefficient = std::exp(-controlInterval / (jmax(0.01f, release) * 0.001 * sampleRate));
+}
+
+void EnvelopeFollower::process(const AudioBuffer<float>& sidechain, AudioBuffer<double>& output, int numSamples, int stride, int firstOutput) {
+    updateCoefficients();
+
+    const auto numChannels = sidechain.getNumChannels();
+    auto* out = output.getWritePointer(0);
+    int untilOutput = firstOutput;
+
+    // Segments never cross a control tick, so detection and the output ramp advance together across blocks
+    for (int smp = 0; smp < numSamples;) {
+        const int segment = jmin(numSamples - smp, controlInterval - chunkPosition);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            measureChannel(sidechain.getReadPointer(ch, smp), segment, chunkPeak, chunkSumOfSquares);
+
+        if (stride == 1) {
+            for (int i = 0; i < segment; ++i)
+                out[smp + i] = value += step;
+        } else {
+            for (int i = 0; i < segment; ++i) {
+                value += step;
+                if (--untilOutput < 0) {
+                    *out++ = value;
+                    untilOutput = stride - 1;
+                }
+            }
+        }
+
+        smp += segment;
+        chunkPosition += segment;
+        if (chunkPosition == controlInterval) {
+            if (numChannels > 0) chunkSumOfSquares /= (float) numChannels;
+            endChunk();
+        }
+    }
+}
+
+void EnvelopeFollower::endChunk() {
+    const double level = detector.load() == rmsDetector ? std::sqrt(chunkSumOfSquares / controlInterval) : chunkPeak;
+    const double coefficient = level > envelope ? attackCoefficient : releaseCoefficient;
+    envelope = jlimit(0.0, 1.0, level + coefficient * (envelope - level));
+
+    // The next tick ramps from where the output is to the new envelope
+    step = (envelope - value) / controlInterval;
+    chunkPeak = chunkSumOfSquares = 0.0f;
+    chunkPosition = 0;
+}
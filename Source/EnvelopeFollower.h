@@ -0,0 +1,42 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Sidechain envelope as a modulation source. The level is detected once per controlInterval samples
+// (peak or RMS across channels, SIMD), smoothed with attack/release at that control rate, and written
+// out as a linear ramp in [0, 1] so the modulation lanes see no steps.
+class EnvelopeFollower {
+public:
+    static constexpr int controlInterval = 32;
+    static constexpr int peakDetector = 0;
+    static constexpr int rmsDetector = 1;
+
+    EnvelopeFollower() = default;
+    ~EnvelopeFollower() = default;
+
+    void prepare(double sampleRate);
+    void setAttack(float milliseconds) { attackMs.store(milliseconds); }
+    void setRelease(float milliseconds) { releaseMs.store(milliseconds); }
+    void setDetector(int newDetector) { detector.store(newDetector); }
+
+    // An empty sidechain (bus disabled) lets the envelope release towards zero. Detection always runs over
+    // every host sample; with a stride the output keeps one value per stride, starting at firstOutput.
+    void process(const AudioBuffer<float>& sidechain, AudioBuffer<double>& output, int numSamples, int stride = 1, int firstOutput = 0);
+
+private:
+    double sampleRate = 44100.0;
+    std::atomic<float> attackMs { 10.0f }, releaseMs { 150.0f };
+    std::atomic<int> detector { peakDetector };
+
+    float cachedAttackMs = -1.0f, cachedReleaseMs = -1.0f;
+    double attackCoefficient = 0.0, releaseCoefficient = 0.0;
+
+    float chunkPeak = 0.0f, chunkSumOfSquares = 0.0f;
+    int chunkPosition = 0;
+    double envelope = 0.0, value = 0.0, step = 0.0;
+
+    void updateCoefficients();
+    void endChunk();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EnvelopeFollower)
+};
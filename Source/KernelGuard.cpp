@@ -0,0 +1,52 @@
+#include "KernelGuard.h"
+
+namespace {
+    // A value is non-finite when every exponent bit is set. Testing the bit pattern rather than comparing
+    // floats stays exact whatever the floating-point mode, and the branchless loop vectorises, so the scan
+    // costs the same whether or not anything is found. Only the rare repair pass depends on the data.
+    template <typename FloatType, typename BitsType, BitsType exponentMask>
+    struct Scan {
+        static bool isNonFinite(FloatType value) {
+            BitsType bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits & exponentMask) == exponentMask;
+        }
+
+        static bool any(const FloatType* data, int numSamples) {
+            BitsType found = 0;
+            for (int smp = 0; smp < numSamples; ++smp)
+                found |= (BitsType) isNonFinite(data[smp]);
+            return found != 0;
+        }
+
+        static void replace(FloatType* data, int numSamples, FloatType replacement) {
+            for (int smp = 0; smp < numSamples; ++smp)
+                if (isNonFinite(data[smp])) data[smp] = replacement;
+        }
+    };
+
+    using FloatScan = Scan<float, uint32, 0x7f800000u>;
+    using DoubleScan = Scan<double, uint64, 0x7ff0000000000000ull>;
+}
+
+namespace KernelGuard {
+
+    bool sanitise(AudioBuffer<float>& buffer) {
+        const auto numSamples = buffer.getNumSamples();
+        bool found = false;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            if (!FloatScan::any(buffer.getReadPointer(ch), numSamples)) continue;
+            FloatScan::replace(buffer.getWritePointer(ch), numSamples, 0.0f);
+            found = true;
+        }
+        return found;
+    }
+
+    void clampLane(double* lane, int numSamples, double minValue, double maxValue) {
+        // The vector clip doesn't define where NaN lands, so those are moved into range first
+        if (DoubleScan::any(lane, numSamples))
+            DoubleScan::replace(lane, numSamples, minValue);
+        FloatVectorOperations::clip(lane, lane, minValue, maxValue, numSamples);
+    }
+}
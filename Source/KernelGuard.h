@@ -0,0 +1,16 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Keeps the crush and hold kernels on their fast path. Those kernels are built with fast-math on every
+// exporter (the KernelFastMath flag scheme in Ralph.jucer: -ffast-math on Xcode, /fp:fast on Visual Studio),
+// and both let the compiler assume NaN and infinity never occur. Their inputs and modulation lanes are
+// therefore cleaned here first, on all platforms. This file must stay on strict floating point.
+namespace KernelGuard {
+
+    // Zeroes every non-finite sample in the buffer, returns true if there was any
+    bool sanitise(AudioBuffer<float>& buffer);
+
+    // Clamps a modulation lane to [minValue, maxValue] in place; non-finite values end up at minValue
+    void clampLane(double* lane, int numSamples, double minValue, double maxValue);
+}
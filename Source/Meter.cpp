@@ -1,37 +1,71 @@
 #include "Meter.h"
 
-Meter::Meter() {
-    alpha = exp(-1.0f / (FPS * RELEASE_TIME));
-    startTimerHz(FPS);
-}
+Meter::Meter() : lastRefreshTime(Time::getMillisecondCounterHiRes()) {}
 
 void Meter::paint(Graphics &g) {
     auto W = getWidth();
     auto H = getHeight();
 
-    if (observedEnvelope != nullptr) {
-        auto envelopeSnapshot = observedEnvelope->get();
-        observedEnvelope->set(envelopeSnapshot * alpha);
+    if (observedSource == nullptr || levels.numChannels == 0) return;
 
-        auto peak = Decibels::gainToDecibels(envelopeSnapshot);
+    const float channelWidth = (W - 2.0f) / levels.numChannels;
 
-        auto barHeight = jmap(peak, DB_FLOOR, 0.0f, 0.0f, H - 2.0f);
-        barHeight = jlimit(0.0f, H - 2.0f, barHeight);
+    for (int ch = 0; ch < levels.numChannels; ++ch) {
+        if (peakHeight[ch] <= 0) continue;
 
-        auto topColour = peak >= 0.0f ? Colours::red : Colours::white;
+        const float x = 1.0f + ch * channelWidth;
+        auto topColour = levels.peak[ch] >= 1.0f ? Colours::red : Colours::white;
         ColourGradient filler = ColourGradient(Colours::white, 0, H, topColour, 0, 0, false);
         filler.addColour(0.8f, Colours::lightblue);
         g.setGradientFill(filler);
 
         g.setOpacity(0.3);
-        g.fillRoundedRectangle(1.0f, H - 1.0f - barHeight, W - 2.0f, barHeight, 4);
+        g.fillRoundedRectangle(x, H - 1.0f - peakHeight[ch], channelWidth, peakHeight[ch], 4);
+        g.fillRoundedRectangle(x + 1.0f, H - 1.0f - rmsHeight[ch], channelWidth - 2.0f, rmsHeight[ch], 3);
     }
 }
 
-void Meter::connectTo(Atomic<float> &targetVariable) {
-    observedEnvelope = &targetVariable;
+void Meter::connectTo(MeterSource& source) {
+    observedSource = &source;
+    observedSource->discardPendingLevels();
+}
+
+int Meter::levelToHeight(float level) const {
+    const auto H = getHeight();
+    const auto dB = Decibels::gainToDecibels(level);
+    return roundToInt(jlimit(0.0f, H - 2.0f, jmap(dB, DB_FLOOR, 0.0f, 0.0f, H - 2.0f)));
 }
 
-void Meter::timerCallback() {
-    repaint();
+Rectangle<int> Meter::getDirtyArea() {
+    if (observedSource == nullptr) return {};
+
+    // The release follows the time elapsed between refreshes, so it doesn't depend on how often the meter is drawn
+    const auto now = Time::getMillisecondCounterHiRes();
+    const auto alpha = std::exp(-0.001f * static_cast<float>(now - lastRefreshTime) / RELEASE_TIME);
+    lastRefreshTime = now;
+
+    for (int ch = 0; ch < levels.numChannels; ++ch) {
+        levels.peak[ch] *= alpha;
+        levels.rms[ch] *= alpha;
+    }
+
+    MeterSource::Levels newLevels;
+    if (observedSource->pullLevels(newLevels)) {
+        levels.numChannels = newLevels.numChannels;
+        for (int ch = 0; ch < newLevels.numChannels; ++ch) {
+            levels.peak[ch] = jmax(levels.peak[ch], newLevels.peak[ch]);
+            levels.rms[ch] = jmax(levels.rms[ch], newLevels.rms[ch]);
+        }
+    }
+
+    bool changed = false;
+    for (int ch = 0; ch < levels.numChannels; ++ch) {
+        const auto newPeakHeight = levelToHeight(levels.peak[ch]);
+        const auto newRmsHeight = levelToHeight(levels.rms[ch]);
+        changed = changed || newPeakHeight != peakHeight[ch] || newRmsHeight != rmsHeight[ch];
+        peakHeight[ch] = newPeakHeight;
+        rmsHeight[ch] = newRmsHeight;
+    }
+
+    return changed ? getLocalBounds() : Rectangle<int>();
 }
@@ -1,24 +1,29 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "RefreshScheduler.h"
+#include "MeterSource.h"
 
-#define FPS 60
 #define RELEASE_TIME 0.30f
 #define DB_FLOOR -48.0f
 
-class Meter : public Component, public Timer {
+class Meter : public Component, public RefreshScheduler::Client {
 public:
     Meter();
 	~Meter() {}
 
     void paint(Graphics& g) override;
-    void connectTo(Atomic<float>& targetVariable);
+    void connectTo(MeterSource& source);
+    Rectangle<int> getDirtyArea() override;
 	
 private:
-	float alpha = 0.0f;
-	Atomic<float>* observedEnvelope = nullptr;
-    
-    void timerCallback() override;
+	MeterSource* observedSource = nullptr;
+    MeterSource::Levels levels;
+    double lastRefreshTime = 0.0;
+    int peakHeight[MeterSource::maxChannels] = {};
+    int rmsHeight[MeterSource::maxChannels] = {};
+
+    int levelToHeight(float level) const;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Meter)
 };
@@ -0,0 +1,138 @@
+#include "MeterSource.h"
+
+namespace {
+    // Blocks up to this size, and blocks where the gain is still ramping, take the scalar path
+    constexpr int smallBlockSize = 32;
+
+    void applyGainAndMeasureChannel(float* data, float gain, int numSamples, float& peak, float& sumOfSquares) {
+        int smp = 0;
+
+       #if JUCE_USE_SIMD
+        using Vector = dsp::SIMDRegister<float>;
+        constexpr int vectorSize = static_cast<int>(Vector::SIMDNumElements);
+
+        const int unaligned = jmin(numSamples, static_cast<int>(Vector::getNextSIMDAlignedPtr(data) - data));
+        for (; smp < unaligned; ++smp) {
+            const float value = data[smp] *= gain;
+            peak = jmax(peak, std::abs(value));
+            sumOfSquares += value * value;
+        }
+
+        const auto vectorGain = Vector::expand(gain);
+        auto vectorPeak = Vector::expand(0.0f);
+        auto vectorSum = Vector::expand(0.0f);
+
+        for (; smp + vectorSize <= numSamples; smp += vectorSize) {
+            const auto value = Vector::fromRawArray(data + smp) * vectorGain;
+            value.copyToRawArray(data + smp);
+            vectorPeak = Vector::max(vectorPeak, Vector::abs(value));
+            vectorSum += value * value;
+        }
+
+        for (size_t i = 0; i < Vector::SIMDNumElements; ++i)
+            peak = jmax(peak, vectorPeak.get(i));
+        sumOfSquares += vectorSum.sum();
+       #endif
+
+        for (; smp < numSamples; ++smp) {
+            const float value = data[smp] *= gain;
+            peak = jmax(peak, std::abs(value));
+            sumOfSquares += value * value;
+        }
+    }
+}
+
+MeterSource::MeterSource() : fifo(fifoSize) {}
+
+void MeterSource::prepare(double sampleRate) {
+    windowSamples = jmax(1, roundToInt(sampleRate * 0.005));
+    pending = {};
+}
+
+void MeterSource::applyGainAndMeasure(AudioBuffer<float>& buffer, SmoothedValue<float, ValueSmoothingTypes::Linear>& gain, int numSamples) {
+    const auto numCh = buffer.getNumChannels();
+    auto data = buffer.getArrayOfWritePointers();
+
+    const auto numMeasured = jmin(numCh, maxChannels);
+    float peak[maxChannels] = {};
+    float sumOfSquares[maxChannels] = {};
+
+    if (gain.isSmoothing() || numSamples <= smallBlockSize) {
+        for (int smp = 0; smp < numSamples; ++smp) {
+            const float currentGain = gain.getNextValue();
+            for (int ch = 0; ch < numCh; ++ch)
+                data[ch][smp] *= currentGain;
+            for (int ch = 0; ch < numMeasured; ++ch) {
+                peak[ch] = jmax(peak[ch], std::abs(data[ch][smp]));
+                sumOfSquares[ch] += data[ch][smp] * data[ch][smp];
+            }
+        }
+    } else {
+        const float currentGain = gain.getTargetValue();
+        for (int ch = 0; ch < numMeasured; ++ch)
+            applyGainAndMeasureChannel(data[ch], currentGain, numSamples, peak[ch], sumOfSquares[ch]);
+        for (int ch = numMeasured; ch < numCh; ++ch)
+            FloatVectorOperations::multiply(data[ch], currentGain, numSamples);
+    }
+
+    pending.numChannels = jmax(pending.numChannels, numMeasured);
+    pending.numSamples += numSamples;
+    for (int ch = 0; ch < numMeasured; ++ch) {
+        pending.peak[ch] = jmax(pending.peak[ch], peak[ch]);
+        pending.sumOfSquares[ch] += sumOfSquares[ch];
+    }
+
+    if (pending.numSamples >= windowSamples) {
+        publish(pending);
+        pending = {};
+    }
+}
+
+void MeterSource::publish(const Frame& frame) {
+    // With no editor draining the FIFO it fills up and further frames are simply dropped
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 > 0) {
+        frames[start1] = frame;
+        fifo.finishedWrite(1);
+    }
+}
+
+bool MeterSource::pullLevels(Levels& levels) {
+    const auto numReady = fifo.getNumReady();
+    if (numReady == 0) return false;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    // Peaks merge as a max, RMS over every sample the frames cover
+    Frame merged;
+    auto merge = [&merged](const Frame& frame) {
+        merged.numChannels = jmax(merged.numChannels, frame.numChannels);
+        merged.numSamples += frame.numSamples;
+        for (int ch = 0; ch < frame.numChannels; ++ch) {
+            merged.peak[ch] = jmax(merged.peak[ch], frame.peak[ch]);
+            merged.sumOfSquares[ch] += frame.sumOfSquares[ch];
+        }
+    };
+
+    for (int i = 0; i < size1; ++i) merge(frames[start1 + i]);
+    for (int i = 0; i < size2; ++i) merge(frames[start2 + i]);
+
+    fifo.finishedRead(size1 + size2);
+
+    levels = {};
+    levels.numChannels = merged.numChannels;
+    for (int ch = 0; ch < merged.numChannels; ++ch) {
+        levels.peak[ch] = merged.peak[ch];
+        if (merged.numSamples > 0)
+            levels.rms[ch] = std::sqrt(merged.sumOfSquares[ch] / (float) merged.numSamples);
+    }
+    return true;
+}
+
+void MeterSource::discardPendingLevels() {
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+    fifo.finishedRead(size1 + size2);
+}
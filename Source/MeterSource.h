@@ -0,0 +1,49 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Audio-thread side of the meters. Each gain stage measures per-channel peak and RMS while applying its gain,
+// accumulates them across blocks, and publishes one frame per window of about 5 ms through a wait-free
+// single-producer/single-consumer FIFO, so the frame rate doesn't depend on the host block size.
+class MeterSource {
+public:
+    static constexpr int maxChannels = 2;
+
+    struct Levels {
+        float peak[maxChannels] = {};
+        float rms[maxChannels] = {};
+        int numChannels = 0;
+    };
+
+    MeterSource();
+    ~MeterSource() = default;
+
+    void prepare(double sampleRate);
+
+    // Audio thread
+    void applyGainAndMeasure(AudioBuffer<float>& buffer, SmoothedValue<float, ValueSmoothingTypes::Linear>& gain, int numSamples);
+
+    // UI thread: merges every frame published since the last call, returns false if there was none
+    bool pullLevels(Levels& levels);
+    void discardPendingLevels();
+
+private:
+    static constexpr int fifoSize = 64;
+
+    // Raw sums, so merged frames give the true RMS over everything they cover
+    struct Frame {
+        float peak[maxChannels] = {};
+        float sumOfSquares[maxChannels] = {};
+        int numSamples = 0;
+        int numChannels = 0;
+    };
+
+    AbstractFifo fifo;
+    std::array<Frame, fifoSize> frames;
+    Frame pending;
+    int windowSamples = 256;
+
+    void publish(const Frame& frame);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterSource)
+};
@@ -0,0 +1,90 @@
+#include "ModulationMatrix.h"
+
+ModulationMatrix::ModulationMatrix() {
+    for (auto& depth : depthTargets)
+        depth.store(0.0);
+}
+
+void ModulationMatrix::prepare(double sampleRate, int maximumBlockSize) {
+    for (auto& buffer : sourceBuffers)
+        buffer.setSize(1, maximumBlockSize, false, false, true);
+
+    for (int i = 0; i < maxRoutes; ++i) {
+        depths[i].reset(sampleRate, 0.02);
+        depths[i].setCurrentAndTargetValue(depthTargets[i].load());
+    }
+}
+
+void ModulationMatrix::setRoute(int index, int source, int target, bool unipolar) {
+    jassert(isPositiveAndBelow(index, maxRoutes) && source < maxSources && isPositiveAndBelow(target, numTargets));
+    const SpinLock::ScopedLockType lock(tableLock);
+    routes[index] = { source, target, unipolar };
+    compile();
+}
+
+void ModulationMatrix::setDepth(int index, double newDepth) {
+    depthTargets[index].store(newDepth);
+}
+
+void ModulationMatrix::compile() {
+    pendingSize = 0;
+    for (int i = 0; i < maxRoutes; ++i)
+        if (routes[i].source != noSource)
+            pendingTable[pendingSize++] = { (uint8_t) i, (uint8_t) routes[i].source, (uint8_t) routes[i].target, routes[i].unipolar };
+    ++version;
+}
+
+void ModulationMatrix::beginBlock() {
+    // Never waits: if the message thread is mid-compile the previous table stays for one more block
+    const auto currentVersion = version.load();
+    if (currentVersion != seenVersion) {
+        const SpinLock::ScopedTryLockType lock(tableLock);
+        if (lock.isLocked()) {
+            std::copy(pendingTable, pendingTable + pendingSize, table);
+            tableSize = pendingSize;
+            seenVersion = currentVersion;
+        }
+    }
+
+    usedSources = 0;
+    for (int i = 0; i < tableSize; ++i) {
+        auto& depth = depths[table[i].route];
+        depth.setTargetValue(depthTargets[table[i].route].load());
+        if (depth.isSmoothing() || depth.getCurrentValue() != 0.0)
+            usedSources |= 1u << table[i].source;
+    }
+}
+
+void ModulationMatrix::process(AudioBuffer<double>* lanes[numLaneTargets], int numSamples) {
+    std::fill(blockOffsets, blockOffsets + numTargets, 0.0);
+    if (numSamples == 0) return;
+
+    for (int i = 0; i < tableSize; ++i) {
+        const auto& entry = table[i];
+        if (!isSourceUsed(entry.source)) continue;
+
+        auto& depth = depths[entry.route];
+        if (!depth.isSmoothing() && depth.getCurrentValue() == 0.0) continue;
+
+        const auto* source = sourceBuffers[entry.source].getReadPointer(0);
+        const double scale = entry.unipolar ? 0.5 : 1.0;
+
+        if (entry.target >= numLaneTargets) {
+            const double amount = depth.skip(numSamples);
+            blockOffsets[entry.target] += amount * (scale * source[numSamples - 1] + (entry.unipolar ? 0.5 : 0.0));
+            continue;
+        }
+
+        auto* lane = lanes[entry.target]->getWritePointer(0);
+        if (depth.isSmoothing()) {
+            for (int smp = 0; smp < numSamples; ++smp) {
+                const double amount = depth.getNextValue();
+                lane[smp] += amount * (scale * source[smp] + (entry.unipolar ? 0.5 : 0.0));
+            }
+        } else {
+            const double amount = depth.getCurrentValue();
+            FloatVectorOperations::addWithMultiply(lane, source, amount * scale, numSamples);
+            if (entry.unipolar) FloatVectorOperations::add(lane, amount * 0.5, numSamples);
+        }
+    }
+}
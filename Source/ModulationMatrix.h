@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Routes modulation sources to targets through a flat table compiled on the message thread.
+// Each block the audio thread multiply-accumulates every live route into its target: per sample
+// into the lanes (bits, rate), once per block for the targets applied through smoothed values.
+class ModulationMatrix {
+public:
+    enum Source { noSource = -1, lfoBCSource = 0, lfoDSSource, sidechainSource, maxSources = 4 };
+    enum Target { bitsTarget = 0, rateTarget, dryWetBCTarget, dryWetDSTarget, dryWetTarget, gainOutTarget, numTargets };
+
+    static constexpr int numLaneTargets = 2;
+    static constexpr int maxRoutes = 8;
+
+    ModulationMatrix();
+    ~ModulationMatrix() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    // Message thread: a unipolar route maps the source from [-1, 1] to [0, 1] before scaling by its depth
+    void setRoute(int index, int source, int target, bool unipolar);
+    void setDepth(int index, double newDepth);
+
+    // Audio thread: picks up routing changes and reports which sources need rendering this block
+    void beginBlock();
+    bool isSourceUsed(int source) const { return (usedSources & (1 << source)) != 0; }
+    AudioBuffer<double>& getSourceBuffer(int source) { return sourceBuffers[source]; }
+
+    void process(AudioBuffer<double>* lanes[numLaneTargets], int numSamples);
+    double getBlockOffset(int target) const { return blockOffsets[target]; }
+
+private:
+    struct Route {
+        int source = noSource;
+        int target = bitsTarget;
+        bool unipolar = false;
+    };
+
+    struct Entry {
+        uint8_t route, source, target;
+        bool unipolar;
+    };
+
+    // Message-thread side: routes, and the flat table they compile into
+    Route routes[maxRoutes];
+    Entry pendingTable[maxRoutes];
+    int pendingSize = 0;
+    SpinLock tableLock;
+    std::atomic<int> version { 0 };
+    std::atomic<double> depthTargets[maxRoutes];
+
+    // Audio-thread side
+    Entry table[maxRoutes];
+    int tableSize = 0;
+    int seenVersion = -1;
+    uint32_t usedSources = 0;
+    SmoothedValue<double, ValueSmoothingTypes::Linear> depths[maxRoutes];
+    AudioBuffer<double> sourceBuffers[maxSources];
+    double blockOffsets[numTargets] = {};
+
+    void compile();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationMatrix)
+};
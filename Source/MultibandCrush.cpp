@@ -0,0 +1,163 @@
+#include "MultibandCrush.h"
+#include "Parameters.h"
+
+MultibandCrush::MultibandCrush() {
+    const float defaults[maxBands - 1] = {Parameters::defaultCrossover[0], Parameters::defaultCrossover[1], Parameters::defaultCrossover[2]};
+    for (int i = 0; i < maxBands - 1; ++i)
+        crossovers[i].store(defaults[i]);
+    for (int band = 0; band < maxBands; ++band) {
+        bandBits[band].store(Parameters::defaultBitDepth);
+        bandRates[band].store(Parameters::defaultSR);
+    }
+
+    for (auto& row : allpasses)
+        for (auto& filter : row)
+            filter.setType(dsp::LinkwitzRileyFilterType::allpass);
+}
+
+void MultibandCrush::prepare(const dsp::ProcessSpec& spec, double referenceRate) {
+    sampleRate = spec.sampleRate;
+    currentReferenceRate = referenceRate;
+    const dsp::ProcessSpec filterSpec {spec.sampleRate, spec.maximumBlockSize, (uint32) maxChannels};
+
+    for (auto& filter : splitters)
+        filter.prepare(filterSpec);
+    for (auto& row : allpasses)
+        for (auto& filter : row)
+            filter.prepare(filterSpec);
+
+    // Forces the next block to rebuild the filters and clear the held values
+    currentNumBands = 0;
+}
+
+void MultibandCrush::setNumBands(int newNumBands) {
+    numBands.store(jlimit(1, maxBands, newNumBands));
+}
+
+void MultibandCrush::setCrossover(int index, float frequency) {
+    crossovers[index].store(frequency);
+}
+
+void MultibandCrush::setBandBits(int band, float bits) {
+    bandBits[band].store(bits);
+}
+
+void MultibandCrush::setBandRate(int band, float rate) {
+    bandRates[band].store(rate);
+}
+
+void MultibandCrush::updateSettings(int bands) {
+    if (bands != currentNumBands) {
+        currentNumBands = bands;
+        std::fill(std::begin(currentCrossovers), std::end(currentCrossovers), 0.0f);
+        for (auto& filter : splitters)
+            filter.reset();
+        for (auto& row : allpasses)
+            for (auto& filter : row)
+                filter.reset();
+        std::fill(counters, counters + numLanes, 0.0f);
+        for (auto& channel : held)
+            std::fill(channel, channel + numLanes, 0.0f);
+    }
+
+    float frequencies[maxBands - 1];
+    for (int i = 0; i < bands - 1; ++i)
+        frequencies[i] = crossovers[i].load();
+    limitCrossovers(frequencies, bands - 1, sampleRate);
+
+    for (int i = 0; i < bands - 1; ++i) {
+        const auto frequency = frequencies[i];
+        if (frequency == currentCrossovers[i]) continue;
+
+        currentCrossovers[i] = frequency;
+        splitters[i].setCutoffFrequency(frequency);
+        for (int band = 0; band < i; ++band)
+            allpasses[band][i - band - 1].setCutoffFrequency(frequency);
+    }
+
+    for (int lane = 0; lane < numLanes; ++lane) {
+        if (lane >= bands) {
+            levels[lane] = inverseLevels[lane] = ratios[lane] = 1.0f;
+            continue;
+        }
+        const auto bits = jlimit(Parameters::minBitDepth, Parameters::maxBitDepth, bandBits[lane].load());
+        levels[lane] = (float) ((std::pow(2.0, (double) bits) - 1.0) * 0.5);
+        inverseLevels[lane] = 1.0f / levels[lane];
+        ratios[lane] = (float) jmax(1, static_cast<int>(currentReferenceRate / jmin((double) bandRates[lane].load(), currentReferenceRate)));
+    }
+}
+
+void MultibandCrush::limitCrossovers(float* frequencies, int numCrossovers, double sampleRate) {
+    constexpr float spacing = 1.15f;
+
+    // Each crossover's ceiling leaves room for the ones above it, so the bounds never cross
+    float lowest = Parameters::minCrossover;
+    for (int i = 0; i < numCrossovers; ++i) {
+        const auto ceiling = (float) (sampleRate * 0.45 / std::pow((double) spacing, (double) (numCrossovers - 1 - i)));
+        lowest = jmin(lowest, ceiling);
+        frequencies[i] = jlimit(lowest, ceiling, frequencies[i]);
+        lowest = frequencies[i] * spacing;
+    }
+}
+
+void MultibandCrush::split(int channel, float input, float* bands, int bandsToSplit) {
+    float rest = input;
+    for (int i = 0; i < bandsToSplit - 1; ++i)
+        splitters[i].processSample(channel, rest, bands[i], rest);
+    bands[bandsToSplit - 1] = rest;
+
+    for (int band = 0; band < bandsToSplit - 2; ++band)
+        for (int crossover = band + 1; crossover < bandsToSplit - 1; ++crossover)
+            bands[band] = allpasses[band][crossover - band - 1].processSample(channel, bands[band]);
+}
+
+void MultibandCrush::processBlock(AudioBuffer<float>& buffer) {
+    const auto bands = numBands.load();
+    updateSettings(bands);
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto numCh = jmin(buffer.getNumChannels(), maxChannels);
+    auto data = buffer.getArrayOfWritePointers();
+
+    // Split writes only the active lanes; the rest stay zero for the whole block
+    alignas(32) float bandSamples[numLanes] = {};
+
+   #if JUCE_USE_SIMD
+    using BandVector = BitCrush::BandVector;
+    const auto levelVector = BandVector::fromRawArray(levels);
+    const auto inverseVector = BandVector::fromRawArray(inverseLevels);
+    const auto ratioVector = BandVector::fromRawArray(ratios);
+    auto counterVector = BandVector::fromRawArray(counters);
+    BandVector heldVectors[maxChannels] = { BandVector::fromRawArray(held[0]), BandVector::fromRawArray(held[1]) };
+
+    for (int smp = 0; smp < numSamples; ++smp) {
+        const auto capture = DownSample::captureMask(counterVector);
+        for (int ch = 0; ch < numCh; ++ch) {
+            split(ch, data[ch][smp], bandSamples, bands);
+            const auto crushed = BitCrush::crushBands(BandVector::fromRawArray(bandSamples), levelVector, inverseVector);
+            DownSample::holdBands(heldVectors[ch], crushed, capture);
+            data[ch][smp] = heldVectors[ch].sum();
+        }
+        DownSample::advanceBandCounters(counterVector, ratioVector);
+    }
+
+    counterVector.copyToRawArray(counters);
+    for (int ch = 0; ch < maxChannels; ++ch)
+        heldVectors[ch].copyToRawArray(held[ch]);
+   #else
+    for (int smp = 0; smp < numSamples; ++smp) {
+        for (int ch = 0; ch < numCh; ++ch) {
+            split(ch, data[ch][smp], bandSamples, bands);
+            float sum = 0.0f;
+            for (int lane = 0; lane < bands; ++lane) {
+                if (counters[lane] == 0.0f)
+                    held[ch][lane] = static_cast<int>(bandSamples[lane] * levels[lane]) * inverseLevels[lane];
+                sum += held[ch][lane];
+            }
+            data[ch][smp] = sum;
+        }
+        for (int lane = 0; lane < bands; ++lane)
+            if (++counters[lane] >= ratios[lane]) counters[lane] = 0.0f;
+    }
+   #endif
+}
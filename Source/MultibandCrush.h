@@ -0,0 +1,63 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BitCrush.h"
+#include "DownSample.h"
+
+// Splits the signal into 2 to 4 bands with Linkwitz-Riley crossovers, crushes and holds each band with
+// its own bit depth and rate, and sums them back. The bands of one sample sit side by side in one SIMD
+// register and go through the BitCrush/DownSample band kernels together, so extra bands only cost
+// their crossover filters.
+class MultibandCrush {
+public:
+    static constexpr int maxBands = 4;
+
+    MultibandCrush();
+    ~MultibandCrush() = default;
+
+    void prepare(const dsp::ProcessSpec& spec, double referenceRate);
+    void setNumBands(int newNumBands);
+    bool isActive() const { return numBands.load() > 1; }
+    void setCrossover(int index, float frequency);
+    void setBandBits(int band, float bits);
+    void setBandRate(int band, float rate);
+    void processBlock(AudioBuffer<float>& buffer);
+
+    // Keeps crossovers ascending, at least a fifth of an octave apart, and below Nyquist, in place
+    static void limitCrossovers(float* frequencies, int numCrossovers, double sampleRate);
+
+private:
+    static constexpr int maxChannels = 2;
+   #if JUCE_USE_SIMD
+    static constexpr int numLanes = jmax(maxBands, (int) BitCrush::BandVector::SIMDNumElements);
+   #else
+    static constexpr int numLanes = maxBands;
+   #endif
+
+    std::atomic<int> numBands { 1 };
+    std::atomic<float> crossovers[maxBands - 1];
+    std::atomic<float> bandBits[maxBands];
+    std::atomic<float> bandRates[maxBands];
+
+    double sampleRate = 44100.0;
+    double currentReferenceRate = 44100.0;
+    int currentNumBands = 0;
+    float currentCrossovers[maxBands - 1] = {};
+
+    // splitters[i] separates band i from everything above it; allpasses[i][j] delays band i through
+    // crossover i + j + 1 so the lower bands stay in phase with the upper ones when summed
+    dsp::LinkwitzRileyFilter<float> splitters[maxBands - 1];
+    dsp::LinkwitzRileyFilter<float> allpasses[maxBands - 2][maxBands - 2];
+
+    // Lanes past the active band count stay at zero: level 1, ratio 1, nothing held
+    alignas(32) float levels[numLanes];
+    alignas(32) float inverseLevels[numLanes];
+    alignas(32) float ratios[numLanes];
+    alignas(32) float counters[numLanes];
+    alignas(32) float held[maxChannels][numLanes];
+
+    void updateSettings(int bands);
+    void split(int channel, float input, float* bands, int bandsToSplit);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultibandCrush)
+};
@@ -25,23 +25,55 @@ void Oscillator::setWaveform(int newValue) {
     waveform = newValue;
 }
 
+void Oscillator::setControlRate(bool enabled) {
+    if (enabled == controlRate) return;
+
+    // Interpolation starts from the last value produced, so switching modes doesn't jump
+    controlRate = enabled;
+    controlCounter = 0;
+    controlValue = lastOutput;
+}
+
 void Oscillator::getNextAudioBlock(AudioBuffer<double>& buffer, int numSamples) {
     const int numChannels = buffer.getNumChannels();
     auto data = buffer.getArrayOfWritePointers();
 
     for (int smp = 0; smp < numSamples; ++smp) {
-        const double sampleValue = getNextAudioSample();
+        double sampleValue;
+
+        if (controlRate) {
+            if (controlCounter == 0) {
+                const double target = getCurrentValue();
+                advancePhase(controlInterval);
+                controlStep = (target - controlValue) / controlInterval;
+                controlCounter = controlInterval;
+            }
+            controlValue += controlStep;
+            --controlCounter;
+            sampleValue = controlValue;
+        } else {
+            sampleValue = getNextAudioSample();
+        }
+
+        lastOutput = sampleValue;
         for (int ch = 0; ch < numChannels; ++ch)
             data[ch][smp] = sampleValue;
     }
 }
 
 float Oscillator::getNextAudioSample() {
+    const double sampleValue = getCurrentValue();
+    advancePhase(1);
+    return static_cast<float>(sampleValue);
+}
+
+double Oscillator::getCurrentValue() {
     double sampleValue = 0.0;
 
     switch (waveform) {
         case SINUSOID:
-            sampleValue = sin(MathConstants<double>::twoPi * currentPhase);
+            sampleValue = fastSine ? -dsp::FastMathApproximations::sin(MathConstants<double>::twoPi * currentPhase - MathConstants<double>::pi)
+                                   : sin(MathConstants<double>::twoPi * currentPhase);
             break;
         case TRIANGULAR:
             sampleValue = 4.0 * fabs(currentPhase - 0.5) - 1.0;
@@ -69,10 +101,13 @@ float Oscillator::getNextAudioSample() {
             break;
     }
 
-    phaseIncrement = frequency.getNextValue() * samplePeriod;
+    return sampleValue;
+}
+
+void Oscillator::advancePhase(int numSamples) {
+    const double currentFrequency = numSamples == 1 ? frequency.getNextValue() : frequency.skip(numSamples);
+    phaseIncrement = currentFrequency * samplePeriod * numSamples;
     currentPhase += phaseIncrement;
     newCycle = currentPhase >= 1.0;
     currentPhase -= static_cast<int>(currentPhase);
-    
-    return static_cast<float>(sampleValue);
 }
@@ -10,12 +10,19 @@ constexpr int SAMPLE_AND_HOLD = 5;
 
 class Oscillator {
 public:
+    // In control-rate mode the waveform is evaluated once every controlInterval samples and interpolated in between
+    static constexpr int controlInterval = 32;
+
     Oscillator(double defaultFrequency = 1.0, int defaultWaveform = SINUSOID);
     ~Oscillator() = default;
 
     void prepareToPlay(double sampleRate);
+    // Changes the rate the phase advances at without resetting it
+    void setSampleRate(double sampleRate) { samplePeriod = 1.0 / sampleRate; }
     void setFrequency(double newValue);
     void setWaveform(int newValue);
+    void setControlRate(bool enabled);
+    void setFastSine(bool enabled) { fastSine = enabled; }
     void getNextAudioBlock(AudioBuffer<double>& buffer, int numSamples);
     float getNextAudioSample();
         
@@ -29,7 +36,17 @@ private:
     float prevValue;
     bool newCycle;
 
+    bool fastSine = false;
+    bool controlRate = false;
+    int controlCounter = 0;
+    double controlValue = 0.0;
+    double controlStep = 0.0;
+    double lastOutput = 0.0;
+
     juce::Random randomGenerator;
 
+    double getCurrentValue();
+    void advancePhase(int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oscillator)
 };
@@ -15,6 +15,24 @@ namespace Parameters {
     const juce::String nameAmountDS = "ADS";
     const juce::String nameWaveformDS = "MWDS";
     const juce::String nameDownSample = "DS";
+    const juce::String nameOversamplingBC = "OSBC";
+    const juce::String nameQuality = "QUAL";
+    const juce::String nameStageOrder = "ORDR";
+    const juce::String nameBypassBC = "BYBC";
+    const juce::String nameBypassDS = "BYDS";
+    const juce::String nameDryWet = "DWGL";
+    const juce::String nameModSource[numModSlots] = {"MS1", "MS2", "MS3", "MS4"};
+    const juce::String nameModTarget[numModSlots] = {"MT1", "MT2", "MT3", "MT4"};
+    const juce::String nameModDepth[numModSlots] = {"MD1", "MD2", "MD3", "MD4"};
+    const juce::String nameSidechainAttack = "SCAT";
+    const juce::String nameSidechainRelease = "SCRL";
+    const juce::String nameSidechainDetector = "SCDT";
+    const juce::String nameBands = "MBND";
+    const juce::String nameCrossover[maxBands - 1] = {"XO1", "XO2", "XO3"};
+    const juce::String nameBandBits[maxBands] = {"BB1", "BB2", "BB3", "BB4"};
+    const juce::String nameBandRate[maxBands] = {"BR1", "BR2", "BR3", "BR4"};
+
+    const juce::StringArray waveformChoices {"Sinusoid", "Triangular", "Saw Up", "Saw Down", "Square", "Sample and Hold"};
 
     // Helper function to create float parameters
     std::unique_ptr<juce::RangedAudioParameter> createFloatParameter(const juce::String& id, const juce::String& name, float minValue, float maxValue, float defaultValue, float step, float skew) {
@@ -26,33 +44,62 @@ namespace Parameters {
         return std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(id, 1), name, choices, defaultChoice);
     }
 
+    // Helper function to create bool parameters
+    std::unique_ptr<juce::RangedAudioParameter> createBoolParameter(const juce::String& id, const juce::String& name, bool defaultValue) {
+        return std::make_unique<juce::AudioParameterBool>(juce::ParameterID(id, 1), name, defaultValue);
+    }
+
     // Create parameter layout
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout() {
         std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
 
+        // The binary state is keyed by parameter index: only ever append new parameters at the end
         parameters.push_back(createFloatParameter(nameGainIn, "Gain IN", minGain, maxGain, defaultGain, 0.1f, 3.0f));
         parameters.push_back(createFloatParameter(nameDryWetDS, "Dry/Wet DS (%) ", 0.0f, 100.0f, defaultDryWet, 0.01f, 1.0f));
         parameters.push_back(createFloatParameter(nameDownSample, "DownSample", minSR, maxSR, defaultSR, 1.0f, 0.4f));
         parameters.push_back(createFloatParameter(nameFreqDS, "LFO Frequency DownSample (Hz)", minFreq, maxFreq, defaultFreq, 0.01f, 0.5f));
         parameters.push_back(createFloatParameter(nameAmountDS, "LFO Amount DownSample (Hz)", 0.0f, modSRRange, defaultAmount, 1.0f, 1.0f));
-        parameters.push_back(createChoiceParameter(nameWaveformDS, "LFO Waveform DownSample", juce::StringArray{"Sinusoid", "Triangular", "Saw Up", "Saw Down", "Square", "Sample and Hold"}, defaultWaveform));
+        parameters.push_back(createChoiceParameter(nameWaveformDS, "LFO Waveform DownSample", waveformChoices, defaultWaveform));
         parameters.push_back(createFloatParameter(nameDryWetBC, "Dry/Wet BC (%)", 0.0f, 100.0f, defaultDryWet, 0.01f, 1.0f));
         parameters.push_back(createFloatParameter(nameBitCrush, "Bits", minBitDepth, maxBitDepth, defaultBitDepth, 0.001f, 0.5f));
         parameters.push_back(createFloatParameter(nameFreqBC, "LFO Frequency BitCrush (Hz)", minFreq, maxFreq, defaultFreq, 0.01f, 0.5f));
         parameters.push_back(createFloatParameter(nameAmountBC, "LFO Amount BitCrush (bits)", 0.0f, modBitRange, defaultAmount, 0.01f, 1.0f));
-        parameters.push_back(createChoiceParameter(nameWaveformBC, "LFO Waveform BitCrush", juce::StringArray{"Sinusoid", "Triangular", "Saw Up", "Saw Down", "Square", "Sample and Hold"}, defaultWaveform));
+        parameters.push_back(createChoiceParameter(nameWaveformBC, "LFO Waveform BitCrush", waveformChoices, defaultWaveform));
         parameters.push_back(createFloatParameter(nameGainOut, "Gain OUT", minGain, maxGain, defaultGain, 0.1f, 3.0f));
+        parameters.push_back(createChoiceParameter(nameOversamplingBC, "Oversampling BitCrush", juce::StringArray{"Off", "2x", "4x", "8x"}, defaultOversampling));
+        parameters.push_back(createChoiceParameter(nameQuality, "Quality", juce::StringArray{"Auto", "Eco", "Render"}, defaultQuality));
+        parameters.push_back(createChoiceParameter(nameStageOrder, "Stage Order", juce::StringArray{"BitCrush > DownSample", "DownSample > BitCrush"}, defaultStageOrder));
+        parameters.push_back(createBoolParameter(nameBypassBC, "Bypass BitCrush", false));
+        parameters.push_back(createBoolParameter(nameBypassDS, "Bypass DownSample", false));
+        parameters.push_back(createFloatParameter(nameDryWet, "Dry/Wet (%)", 0.0f, 100.0f, defaultDryWet, 0.01f, 1.0f));
+
+        for (int slot = 0; slot < numModSlots; ++slot) {
+            const auto prefix = "Mod " + juce::String(slot + 1) + " ";
+            parameters.push_back(createChoiceParameter(nameModSource[slot], prefix + "Source", juce::StringArray{"None", "LFO BitCrush", "LFO DownSample", "Sidechain"}, 0));
+            parameters.push_back(createChoiceParameter(nameModTarget[slot], prefix + "Target", juce::StringArray{"Bits", "DownSample", "Dry/Wet BC", "Dry/Wet DS", "Dry/Wet", "Gain OUT"}, 0));
+            parameters.push_back(createFloatParameter(nameModDepth[slot], prefix + "Depth (%)", -100.0f, 100.0f, 0.0f, 0.01f, 1.0f));
+        }
+
+        parameters.push_back(createFloatParameter(nameSidechainAttack, "Sidechain Attack (ms)", 0.1f, 200.0f, defaultSidechainAttack, 0.1f, 0.4f));
+        parameters.push_back(createFloatParameter(nameSidechainRelease, "Sidechain Release (ms)", 5.0f, 2000.0f, defaultSidechainRelease, 1.0f, 0.4f));
+        parameters.push_back(createChoiceParameter(nameSidechainDetector, "Sidechain Detector", juce::StringArray{"Peak", "RMS"}, 0));
+
+        parameters.push_back(createChoiceParameter(nameBands, "Multiband", juce::StringArray{"Off", "2 Bands", "3 Bands", "4 Bands"}, 0));
+        for (int i = 0; i < maxBands - 1; ++i)
+            parameters.push_back(createFloatParameter(nameCrossover[i], "Crossover " + juce::String(i + 1) + " (Hz)", minCrossover, maxCrossover, defaultCrossover[i], 1.0f, 0.25f));
+        for (int band = 0; band < maxBands; ++band) {
+            const auto prefix = "Band " + juce::String(band + 1) + " ";
+            parameters.push_back(createFloatParameter(nameBandBits[band], prefix + "Bits", minBitDepth, maxBitDepth, defaultBitDepth, 0.001f, 0.5f));
+            parameters.push_back(createFloatParameter(nameBandRate[band], prefix + "DownSample", minSR, maxSR, defaultSR, 1.0f, 0.4f));
+        }
 
         return { parameters.begin(), parameters.end() };
     }
 
     // Add listeners to all parameters
     void addListenerToAllParameters(juce::AudioProcessorValueTreeState& valueTreeState, juce::AudioProcessorValueTreeState::Listener* listener) {
-        std::unique_ptr<juce::XmlElement> xml(valueTreeState.copyState().createXml());
-
-        for (auto* element : xml->getChildWithTagNameIterator("PARAM")) {
-            const juce::String& id = element->getStringAttribute("id");
-            valueTreeState.addParameterListener(id, listener);
-        }
+        for (auto* param : valueTreeState.processor.getParameters())
+            if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+                valueTreeState.addParameterListener(withID->paramID, listener);
     }
 }
@@ -7,9 +7,13 @@ namespace Parameters {
     constexpr float maxBitDepth = 24.0f;
     constexpr float minBitDepth = 3.0f;
     constexpr float modBitRange = 4.0f;
+    // DownSample values are relative to the host rate: maxSR stands for the host rate itself
+    // (no hold), and every other value scales with it, so 22050 halves the rate at any host rate
     constexpr float maxSR = 44100.0f;
     constexpr float minSR = 500.0f;
     constexpr float modSRRange = 10000.0;
+    constexpr float minCrossover = 20.0f;
+    constexpr float maxCrossover = 18000.0f;
     constexpr float maxFreq = 60.0f;
     constexpr float minFreq = 0.01f;
     constexpr float minGain = -48.0f;
@@ -28,6 +32,28 @@ namespace Parameters {
     extern const juce::String nameAmountDS;
     extern const juce::String nameWaveformDS;
     extern const juce::String nameDownSample;
+    extern const juce::String nameOversamplingBC;
+    extern const juce::String nameQuality;
+    extern const juce::String nameStageOrder;
+    extern const juce::String nameBypassBC;
+    extern const juce::String nameBypassDS;
+    extern const juce::String nameDryWet;
+
+    // Modulation matrix slots, on top of the fixed LFO BC -> Bits and LFO DS -> DownSample routes
+    constexpr int numModSlots = 4;
+    extern const juce::String nameModSource[numModSlots];
+    extern const juce::String nameModTarget[numModSlots];
+    extern const juce::String nameModDepth[numModSlots];
+    extern const juce::String nameSidechainAttack;
+    extern const juce::String nameSidechainRelease;
+    extern const juce::String nameSidechainDetector;
+
+    // Multiband mode: band count, crossovers between adjacent bands, and per-band bits and rate
+    constexpr int maxBands = 4;
+    extern const juce::String nameBands;
+    extern const juce::String nameCrossover[maxBands - 1];
+    extern const juce::String nameBandBits[maxBands];
+    extern const juce::String nameBandRate[maxBands];
 
     // PARAM DEFAULTS
     constexpr float defaultGain = 0.0f;
@@ -37,6 +63,17 @@ namespace Parameters {
     constexpr float defaultSR = 44100.0f;
     constexpr float defaultBitDepth = 24.0f;
     constexpr int defaultWaveform = 0;
+    constexpr int defaultOversampling = 0;
+    constexpr int defaultQuality = 0;
+    constexpr int defaultStageOrder = 0;
+    constexpr float defaultSidechainAttack = 10.0f;
+    constexpr float defaultSidechainRelease = 150.0f;
+    constexpr float defaultCrossover[maxBands - 1] = {200.0f, 1000.0f, 5000.0f};
+
+    // QUALITY TIERS
+    constexpr int qualityAuto = 0;
+    constexpr int qualityEco = 1;
+    constexpr int qualityRender = 2;
 
     // Helper function to create float parameters
     std::unique_ptr<juce::RangedAudioParameter> createFloatParameter(const juce::String& id, const juce::String& name, float minValue, float maxValue, float defaultValue, float step = 0.1f, float skew = 1.0f);
@@ -44,6 +81,9 @@ namespace Parameters {
     // Helper function to create choice parameters
     std::unique_ptr<juce::RangedAudioParameter> createChoiceParameter(const juce::String& id, const juce::String& name, const juce::StringArray& choices, int defaultChoice);
 
+    // Helper function to create bool parameters
+    std::unique_ptr<juce::RangedAudioParameter> createBoolParameter(const juce::String& id, const juce::String& name, bool defaultValue);
+
     // Create parameter layout
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -6,40 +6,11 @@ constexpr int BG_GRAY = 0xFF2F2E29;
 constexpr int DARK_GRAY = 0xFF20221E;
 
 RalphComponent::RalphComponent(RalphAudioProcessor& p, AudioProcessorValueTreeState& vts)
-: audioProcessor(p), parameters(vts), lookAndFeel(), lookAndFeelLessTick() {
+: audioProcessor(p), parameters(vts), lookAndFeel(), lookAndFeelLessTick(), refreshScheduler(*this) {
     
+    setOpaque(true);
     lookAndFeelLessTick.setNumTicks(6);
 
-    // Load images
-    backgroundTexture = juce::ImageFileFormat::loadFrom(BinaryData::texture_jpg, BinaryData::texture_jpgSize);
-    glassTexture = juce::ImageFileFormat::loadFrom(BinaryData::glass_png, BinaryData::glass_pngSize);
-    screwImage = juce::ImageFileFormat::loadFrom(BinaryData::screw_png, BinaryData::screw_pngSize);
-    ralphWrite = juce::ImageFileFormat::loadFrom(BinaryData::ralph_png, BinaryData::ralph_pngSize);
-    bitCrushWrite = juce::ImageFileFormat::loadFrom(BinaryData::bitCrush_png, BinaryData::bitCrush_pngSize);
-    downSampleWrite = juce::ImageFileFormat::loadFrom(BinaryData::downSample_png, BinaryData::downSample_pngSize);
-    amountWrite = juce::ImageFileFormat::loadFrom(BinaryData::amount_png, BinaryData::amount_pngSize);
-    dryWetWrite = juce::ImageFileFormat::loadFrom(BinaryData::dryWet_png, BinaryData::dryWet_pngSize);
-    frequencyWrite = juce::ImageFileFormat::loadFrom(BinaryData::frequency_png, BinaryData::frequency_pngSize);
-    bitsWrite = juce::ImageFileFormat::loadFrom(BinaryData::bits_png, BinaryData::bits_pngSize);
-    hertzWrite = juce::ImageFileFormat::loadFrom(BinaryData::hertz_png, BinaryData::hertz_pngSize);
-    zeroImage = juce::ImageFileFormat::loadFrom(BinaryData::zero_png, BinaryData::zero_pngSize);
-    hundredImage = juce::ImageFileFormat::loadFrom(BinaryData::hundred_png, BinaryData::hundred_pngSize);
-    pointOOneImage = juce::ImageFileFormat::loadFrom(BinaryData::pointOOne_png, BinaryData::pointOOne_pngSize);
-    sixtyImage = juce::ImageFileFormat::loadFrom(BinaryData::sixty_png, BinaryData::sixty_pngSize);
-    fourImage = juce::ImageFileFormat::loadFrom(BinaryData::four_png, BinaryData::four_pngSize);
-    threeImage = juce::ImageFileFormat::loadFrom(BinaryData::three_png, BinaryData::three_pngSize);
-    tenKImage = juce::ImageFileFormat::loadFrom(BinaryData::tenK_png, BinaryData::tenK_pngSize);
-    twentyFourImage = juce::ImageFileFormat::loadFrom(BinaryData::twentyFour_png, BinaryData::twentyFour_pngSize);
-    fiveHundredImage = juce::ImageFileFormat::loadFrom(BinaryData::fiveHundred_png, BinaryData::fiveHundred_pngSize);
-    fourFourKImage = juce::ImageFileFormat::loadFrom(BinaryData::fourFourK_png, BinaryData::fourFourK_pngSize);
-    triImage = juce::ImageFileFormat::loadFrom(BinaryData::tri_png, BinaryData::tri_pngSize);
-    sinImage = juce::ImageFileFormat::loadFrom(BinaryData::sin_png, BinaryData::sin_pngSize);
-    sawUpImage = juce::ImageFileFormat::loadFrom(BinaryData::sawUp_png, BinaryData::sawUp_pngSize);;
-    sawDownImage = juce::ImageFileFormat::loadFrom(BinaryData::sawDown_png, BinaryData::sawDown_pngSize);;
-    quadImage = juce::ImageFileFormat::loadFrom(BinaryData::quad_png, BinaryData::quad_pngSize);;
-    shImage = juce::ImageFileFormat::loadFrom(BinaryData::sh_png, BinaryData::sh_pngSize);;
-
-
     // Setup sliders
     setupSlider(gainINSlider, Slider::RotaryVerticalDrag, 25, 500, 30, 30, lookAndFeel);
     setupSlider(gainOUTSlider, Slider::RotaryVerticalDrag, 745, 500, 30, 30, lookAndFeel);
@@ -78,17 +49,53 @@ RalphComponent::RalphComponent(RalphAudioProcessor& p, AudioProcessorValueTreeSt
     meterIN = std::make_unique<Meter>();
     addAndMakeVisible(meterIN.get());
     meterIN->setBounds(31, 121, 18, 368);
-    meterIN->connectTo(audioProcessor.envelopeIN);
+    meterIN->connectTo(audioProcessor.meterSourceIN);
 
     meterOUT = std::make_unique<Meter>();
     addAndMakeVisible(meterOUT.get());
     meterOUT->setBounds(751, 121, 18, 368);
-    meterOUT->connectTo(audioProcessor.envelopeOUT);
+    meterOUT->connectTo(audioProcessor.meterSourceOUT);
+
+    // Setup spectrum overlay
+    spectrumOverlay = std::make_unique<SpectrumOverlay>(audioProcessor.analyzer);
+    addAndMakeVisible(spectrumOverlay.get());
+    spectrumOverlay->setBounds(440, 25, 300, 90);
+
+    // Refresh meters, spectra and slider overlays from one display-synced tick
+    refreshScheduler.addClient(*meterIN, *meterIN);
+    refreshScheduler.addClient(*meterOUT, *meterOUT);
+    refreshScheduler.addClient(*spectrumOverlay, *spectrumOverlay);
+    for (auto* slider : {&gainINSlider, &gainOUTSlider, &BitCrushSlider, &AmountBCSlider, &FreqBCSlider, &DryWetBCSlider,
+                         &DownSampleSlider, &AmountDSSlider, &FreqDSSlider, &DryWetDSSlider})
+        refreshScheduler.addClient(*slider, *slider);
 }
 
 RalphComponent::~RalphComponent() {}
 
 void RalphComponent::paint(juce::Graphics& g) {
+    // The static layer is rendered once per physical scale (editor size and display DPI), so the meters and
+    // sliders repainting on top of it only cost a blit of their own area
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (staticLayer.isNull() || scale != staticLayerScale)
+        renderStaticLayer(scale);
+
+    g.drawImageTransformed(staticLayer, AffineTransform::scale(1.0f / staticLayerScale));
+}
+
+void RalphComponent::resized() {
+    staticLayer = {};
+}
+
+void RalphComponent::renderStaticLayer(float scale) {
+    staticLayerScale = scale;
+    staticLayer = Image(Image::RGB, jmax(1, roundToInt(getWidth() * scale)), jmax(1, roundToInt(getHeight() * scale)), false);
+
+    Graphics g(staticLayer);
+    g.addTransform(AffineTransform::scale(scale));
+    drawStaticLayer(g);
+}
+
+void RalphComponent::drawStaticLayer(Graphics& g) {
     drawBackground(g);
     drawMacroSections(g);
     drawMeters(g);
@@ -96,41 +103,38 @@ void RalphComponent::paint(juce::Graphics& g) {
     drawTextures(g);
     drawScrews(g);
     
-    g.drawImageWithin(zeroImage, 270, 535, 7, 8, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(zeroImage, 590, 535, 7, 8, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(hundredImage, 320, 535, 15, 8, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(hundredImage, 640, 535, 15, 8, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(pointOOneImage, 270, 410, 17, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(pointOOneImage, 590, 410, 17, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sixtyImage, 315, 410, 13, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sixtyImage, 635, 410, 13, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(zeroImage, 147, 417, 9, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(zeroImage, 467, 417, 9, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(fourImage, 203, 417, 10, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(tenKImage, 520, 417, 18, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(threeImage, 155, 235, 10, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(twentyFourImage, 305, 235, 18, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(fiveHundredImage, 470, 235, 20, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(fourFourKImage, 620, 235, 27, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->zeroImage, 270, 535, 7, 8, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->zeroImage, 590, 535, 7, 8, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->hundredImage, 320, 535, 15, 8, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->hundredImage, 640, 535, 15, 8, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->pointOOneImage, 270, 410, 17, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->pointOOneImage, 590, 410, 17, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sixtyImage, 315, 410, 13, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sixtyImage, 635, 410, 13, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->zeroImage, 147, 417, 9, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->zeroImage, 467, 417, 9, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->fourImage, 203, 417, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->tenKImage, 520, 417, 18, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->threeImage, 155, 235, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->twentyFourImage, 305, 235, 18, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->fiveHundredImage, 470, 235, 20, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->fourFourKImage, 620, 235, 27, 10, juce::RectanglePlacement::stretchToFit);
     
     g.setOpacity(0.7);
-    g.drawImageWithin(triImage, 135, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(triImage, 455, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sawUpImage, 155, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sawUpImage, 475, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sawDownImage, 193, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sawDownImage, 513, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(quadImage, 215, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(quadImage, 535, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->triImage, 135, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->triImage, 455, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sawUpImage, 155, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sawUpImage, 475, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sawDownImage, 193, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sawDownImage, 513, 460, 12, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->quadImage, 215, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->quadImage, 535, 493, 10, 10, juce::RectanglePlacement::stretchToFit);
 
     g.setOpacity(0.6);
-    g.drawImageWithin(sinImage, 150, 528, 17, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(sinImage, 470, 528, 17, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(shImage, 193, 528, 20, 10, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(shImage, 513, 528, 20, 10, juce::RectanglePlacement::stretchToFit);
-}
-void RalphComponent::resized() {
-    
+    g.drawImageWithin(assets->sinImage, 150, 528, 17, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->sinImage, 470, 528, 17, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->shImage, 193, 528, 20, 10, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->shImage, 513, 528, 20, 10, juce::RectanglePlacement::stretchToFit);
 }
 
 void RalphComponent::setupSlider(Slider& slider, Slider::SliderStyle style, int x, int y, int w, int h, CustomLookAndFeel& lookAndFeel) {
@@ -169,35 +173,35 @@ void RalphComponent::drawTexts(Graphics& g) {
     g.drawText("IN", 20, 97, 40, 20, Justification::horizontallyCentred);
     g.drawText("OUT", 740, 97, 40, 20, Justification::horizontallyCentred);
 
-    g.drawImageWithin(amountWrite, 143, 310, 70, 25, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(amountWrite, 463, 310, 70, 25, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(frequencyWrite, 262, 320, 70, 25, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(frequencyWrite, 582, 320, 70, 25, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(dryWetWrite, 270, 430, 60, 30, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(dryWetWrite, 590, 430, 60, 30, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(bitsWrite, 220, 275, 40, 20, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(hertzWrite, 530, 275, 50, 25, juce::RectanglePlacement::centred);
-
-    g.drawImageWithin(ralphWrite, 130, 0, 280, 130, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(bitCrushWrite, 130, 150, 210, 60, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(downSampleWrite, 440, 150, 230, 70, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->amountWrite, 143, 310, 70, 25, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->amountWrite, 463, 310, 70, 25, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->frequencyWrite, 262, 320, 70, 25, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->frequencyWrite, 582, 320, 70, 25, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->dryWetWrite, 270, 430, 60, 30, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->dryWetWrite, 590, 430, 60, 30, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->bitsWrite, 220, 275, 40, 20, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->hertzWrite, 530, 275, 50, 25, juce::RectanglePlacement::centred);
+
+    g.drawImageWithin(assets->ralphWrite, 130, 0, 280, 130, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->bitCrushWrite, 130, 150, 210, 60, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->downSampleWrite, 440, 150, 230, 70, juce::RectanglePlacement::stretchToFit);
 }
 
 void RalphComponent::drawTextures(Graphics& g) {
     g.setOpacity(0.12);
-    g.drawImageWithin(backgroundTexture, 0, 0, 800, 600, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->backgroundTexture, 0, 0, 800, 600, juce::RectanglePlacement::stretchToFit);
 
     g.setOpacity(1);
-    g.drawImageWithin(glassTexture, 30, 120, 20, 370, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(glassTexture, 750, 120, 20, 370, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->glassTexture, 30, 120, 20, 370, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->glassTexture, 750, 120, 20, 370, juce::RectanglePlacement::stretchToFit);
 }
 
 void RalphComponent::drawScrews(Graphics& g) {
     g.setOpacity(1);
-    g.drawImageWithin(screwImage, 10, 10, 17, 17, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(screwImage, 775, 10, 17, 17, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(screwImage, 775, 575, 17, 17, juce::RectanglePlacement::stretchToFit);
-    g.drawImageWithin(screwImage, 10, 575, 17, 17, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->screwImage, 10, 10, 17, 17, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->screwImage, 775, 10, 17, 17, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->screwImage, 775, 575, 17, 17, juce::RectanglePlacement::stretchToFit);
+    g.drawImageWithin(assets->screwImage, 10, 575, 17, 17, juce::RectanglePlacement::stretchToFit);
 }
 
 
@@ -5,6 +5,9 @@
 #include "CustomLookAndFeel.h"
 #include "Meter.h"
 #include "TimedSlider.h"
+#include "SharedAssets.h"
+#include "RefreshScheduler.h"
+#include "SpectrumOverlay.h"
 
 typedef AudioProcessorValueTreeState::SliderAttachment SliderAttachment;
 
@@ -23,12 +26,12 @@ private:
     CustomLookAndFeel lookAndFeel, lookAndFeelLessTick;
 
     std::unique_ptr<Meter> meterIN, meterOUT;
+    std::unique_ptr<SpectrumOverlay> spectrumOverlay;
 
-    Image backgroundTexture, glassTexture, screwImage;
-    Image ralphWrite, bitCrushWrite, downSampleWrite;
-    Image bitsWrite, hertzWrite, frequencyWrite, amountWrite, dryWetWrite, waveformWrite;
-    Image zeroImage, hundredImage, pointOOneImage, sixtyImage, threeImage, fourImage, tenKImage, twentyFourImage, fiveHundredImage, fourFourKImage;
-    Image triImage, sinImage, sawUpImage, sawDownImage, quadImage, shImage;
+    SharedResourcePointer<SharedAssets> assets;
+
+    Image staticLayer;
+    float staticLayerScale = 1.0f;
 
     TimedSlider gainINSlider, gainOUTSlider;
     TimedSlider BitCrushSlider, AmountBCSlider, FreqBCSlider, DryWetBCSlider;
@@ -39,8 +42,12 @@ private:
     std::unique_ptr<SliderAttachment> BitCrushAttachment, AmountBCAttachment, FreqBCAttachment, DryWetBCAttachment, WaveformBCAttachment;
     std::unique_ptr<SliderAttachment> DownSampleAttachment, DryWetDSAttachment, FreqDSAttachment, AmountDSAttachment, WaveformDSAttachment;
 
+    RefreshScheduler refreshScheduler;
+
     void setupSlider(Slider& slider, Slider::SliderStyle style, int x, int y, int w, int h, CustomLookAndFeel& lookAndFeel);
     
+    void renderStaticLayer(float scale);
+    void drawStaticLayer(Graphics& g);
     void drawBackground(Graphics& g);
     void drawMacroSections(Graphics& g);
     void drawMeters(Graphics& g);
@@ -3,93 +3,400 @@
 #include "Parameters.h"
 
 RalphAudioProcessor::RalphAudioProcessor() :
+    AudioProcessor(BusesProperties()
+                   .withInput("Input", AudioChannelSet::stereo(), true)
+                   .withOutput("Output", AudioChannelSet::stereo(), true)
+                   .withInput("Sidechain", AudioChannelSet::stereo(), false)),
     parameters(*this, nullptr, "PARAMS", Parameters::createParameterLayout()),
     bitCrush(),
     lfoBC(Parameters::defaultFreq, Parameters::defaultWaveform),
-    BCModCtrl(Parameters::defaultBitDepth, Parameters::defaultAmount),
+    BCModCtrl(Parameters::defaultBitDepth),
     downSample(),
     lfoDS(Parameters::defaultFreq, Parameters::defaultWaveform),
-    DSModCtrl(Parameters::defaultSR, Parameters::defaultAmount)
+    DSModCtrl(Parameters::defaultSR),
+    graph(bitCrush, downSample, multiband)
 {
     GainIn.setCurrentAndTargetValue(1.0f);
     GainOut.setCurrentAndTargetValue(1.0f);
+
+    // The LFO Amount parameters are the depths of the two fixed routes; the slots follow them
+    matrix.setRoute(bcAmountRoute, ModulationMatrix::lfoBCSource, ModulationMatrix::bitsTarget, true);
+    matrix.setRoute(dsAmountRoute, ModulationMatrix::lfoDSSource, ModulationMatrix::rateTarget, true);
+
+    createSetters();
+
+    downSampleValue = parameters.getRawParameterValue(Parameters::nameDownSample);
+    amountDSValue = parameters.getRawParameterValue(Parameters::nameAmountDS);
+    dryWetDSValue = parameters.getRawParameterValue(Parameters::nameDryWetDS);
+    dryWetValue = parameters.getRawParameterValue(Parameters::nameDryWet);
+    bypassDSValue = parameters.getRawParameterValue(Parameters::nameBypassDS);
+    for (int slot = 0; slot < Parameters::numModSlots; ++slot) {
+        modSourceValues[slot] = parameters.getRawParameterValue(Parameters::nameModSource[slot]);
+        modTargetValues[slot] = parameters.getRawParameterValue(Parameters::nameModTarget[slot]);
+        modDepthValues[slot] = parameters.getRawParameterValue(Parameters::nameModDepth[slot]);
+    }
     Parameters::addListenerToAllParameters(parameters, this);
+    presetBank->open(getParameters());
 }
 
 RalphAudioProcessor::~RalphAudioProcessor() {}
 
 void RalphAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock) {
-    auto numCh = jmax(getTotalNumOutputChannels(), getTotalNumInputChannels());
+    auto numCh = jmax(getMainBusNumOutputChannels(), getMainBusNumInputChannels());
+
+    // Everything is prepared at the host rate. While the decimated domain is engaged the same chain runs at the
+    // internal rate with the LFOs and the hold's counter switched over; smoothing ramps just last longer there.
+    domain.prepare(sampleRate, samplesPerBlock, numCh);
+    processingDecimated = false;
+
     dsp::ProcessSpec spec {sampleRate, (uint32)samplesPerBlock, (uint32)numCh};
     bitCrush.prepare(spec);
+    multiband.prepare(spec, Parameters::maxSR);
+    setLatencySamples(getStageLatency());
     GainIn.reset(sampleRate, 0.02);
     GainOut.reset(sampleRate, 0.02);
-    downSample.prepareToPlay(sampleRate, samplesPerBlock, spec);
+    downSample.prepareToPlay(sampleRate, Parameters::maxSR);
+    graph.prepare(spec, bitCrush.getMaxLatencySamples());
+
+    // Both modulation lanes share one allocation, kept across re-prepares that don't need more room
+    modulationLanes.setSize(2, samplesPerBlock, false, false, true);
+    BCMod.setDataToReferTo(modulationLanes.getArrayOfWritePointers(), 1, samplesPerBlock);
+    DSMod.setDataToReferTo(modulationLanes.getArrayOfWritePointers() + 1, 1, samplesPerBlock);
+
     lfoBC.prepareToPlay(sampleRate);
-    BCMod.setSize(2, samplesPerBlock);
     BCModCtrl.prepareToPlay(sampleRate);
     lfoDS.prepareToPlay(sampleRate);
-    DSMod.setSize(2, samplesPerBlock);
     DSModCtrl.prepareToPlay(sampleRate);
+    matrix.prepare(sampleRate, samplesPerBlock);
+    sidechainFollower.prepare(sampleRate);
+    meterSourceIN.prepare(sampleRate);
+    meterSourceOUT.prepare(sampleRate);
+    analyzer.setSampleRate(sampleRate);
+    currentQualityTier = -1;
 }
 
 void RalphAudioProcessor::releaseResources() {
     BCMod.setSize(0, 0);
-    downSample.releaseResources();
     DSMod.setSize(0, 0);
+    modulationLanes.setSize(0, 0);
 }
 
-void RalphAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+// Main bus mono or stereo, in matching out; the sidechain is optional and may be mono or stereo
+bool RalphAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    const auto main = layouts.getMainOutputChannelSet();
+    if (main != AudioChannelSet::mono() && main != AudioChannelSet::stereo()) return false;
+    if (main != layouts.getMainInputChannelSet()) return false;
+
+    const auto sidechain = layouts.getChannelSet(true, 1);
+    return sidechain.isDisabled() || sidechain == AudioChannelSet::mono() || sidechain == AudioChannelSet::stereo();
+}
+
+void RalphAudioProcessor::processBlock (juce::AudioBuffer<float>& hostBuffer, juce::MidiBuffer& midiMessages) {
     juce::ScopedNoDenormals noDenormals;
+    // One scan covers the main and sidechain inputs; the fast-math kernels downstream assume finite data
+    KernelGuard::sanitise(hostBuffer);
+    auto buffer = getBusBuffer(hostBuffer, true, 0);
     const auto numSamples = buffer.getNumSamples();
+    if (const auto program = pendingProgram.exchange(-1); program >= 0)
+        applyProgram(program);
+    updateQualityTier();
     
-    GainIn.applyGain(buffer, numSamples);
-    envelopeIN.set(jmax(envelopeIN.get(), buffer.getMagnitude(0, numSamples)));
+    meterSourceIN.applyGainAndMeasure(buffer, GainIn, numSamples);
+    analyzer.pushInput(buffer, numSamples);
+
+    const bool decimated = domain.beginBlock(buffer, wantsDecimation());
+    if (decimated != processingDecimated) {
+        processingDecimated = decimated;
+        const auto rate = decimated ? domain.getInternalSampleRate() : getSampleRate();
+        lfoBC.setSampleRate(rate);
+        lfoDS.setSampleRate(rate);
+        downSample.setDecimationFactor(decimated ? domain.getFactor() : 1);
+    }
+
+    int firstKept = 0;
+    auto& inner = decimated ? domain.decimate(firstKept) : buffer;
+    const auto numInner = inner.getNumSamples();
+
+    // Sources no route listens to aren't rendered at all
+    matrix.beginBlock();
+    if (matrix.isSourceUsed(ModulationMatrix::lfoBCSource))
+        lfoBC.getNextAudioBlock(matrix.getSourceBuffer(ModulationMatrix::lfoBCSource), numInner);
+    if (matrix.isSourceUsed(ModulationMatrix::lfoDSSource))
+        lfoDS.getNextAudioBlock(matrix.getSourceBuffer(ModulationMatrix::lfoDSSource), numInner);
+    if (matrix.isSourceUsed(ModulationMatrix::sidechainSource))
+        sidechainFollower.process(getBusBuffer(hostBuffer, true, 1), matrix.getSourceBuffer(ModulationMatrix::sidechainSource), numSamples, decimated ? domain.getFactor() : 1, firstKept);
 
-    lfoDS.getNextAudioBlock(DSMod, numSamples);
-    DSModCtrl.processBlock(DSMod, numSamples);
-    lfoBC.getNextAudioBlock(BCMod, numSamples);
-    BCModCtrl.processBlock(BCMod, numSamples);
+    BCModCtrl.processBlock(BCMod, numInner);
+    DSModCtrl.processBlock(DSMod, numInner);
+    AudioBuffer<double>* lanes[ModulationMatrix::numLaneTargets] = { &BCMod, &DSMod };
+    matrix.process(lanes, numInner);
+    // Clamped here once per block, the crush never sees a collapsed level and the hold ratio stays positive
+    KernelGuard::clampLane(BCMod.getWritePointer(0), numInner, (double) Parameters::minBitDepth, (double) Parameters::maxBitDepth);
+    KernelGuard::clampLane(DSMod.getWritePointer(0), numInner, (double) Parameters::minSR, (double) (Parameters::maxSR + Parameters::modSRRange));
+
+    bitCrush.setDryWetModulation((float) matrix.getBlockOffset(ModulationMatrix::dryWetBCTarget));
+    downSample.setDryWetModulation((float) matrix.getBlockOffset(ModulationMatrix::dryWetDSTarget));
+    graph.setDryWetModulation((float) matrix.getBlockOffset(ModulationMatrix::dryWetTarget));
+    const auto gainOutDB = gainOutDecibels.load() + (float) matrix.getBlockOffset(ModulationMatrix::gainOutTarget);
+    GainOut.setTargetValue(Decibels::decibelsToGain(jlimit(Parameters::minGain, Parameters::maxGain, gainOutDB)));
     
-    bitCrush.processBlock(buffer, BCMod);
-    downSample.processBlock(buffer, DSMod);
+    if (numInner > 0) graph.processBlock(inner, BCMod, DSMod, getStageLatency());
+    domain.endBlock(buffer);
     
-    GainOut.applyGain(buffer, numSamples);
-    envelopeOUT.set(jmax(envelopeOUT.get(), buffer.getMagnitude(0, numSamples)));
-
+    meterSourceOUT.applyGainAndMeasure(buffer, GainOut, numSamples);
+    analyzer.pushOutput(buffer, numSamples);
 }
 
 void RalphAudioProcessor::parameterChanged(const String& paramID, float newValue) {
-    if (paramID == Parameters::nameDryWetDS) downSample.setDryWet(newValue * 0.01);
-    if (paramID == Parameters::nameFreqDS) lfoDS.setFrequency(newValue);
-    if (paramID == Parameters::nameWaveformDS) lfoDS.setWaveform(roundToInt(newValue));
-    if (paramID == Parameters::nameAmountDS) DSModCtrl.setModAmount(newValue);
-    if (paramID == Parameters::nameDownSample) DSModCtrl.setParameter(newValue);
-    if (paramID == Parameters::nameDryWetBC) bitCrush.setDryWet(newValue * 0.01);
-    if (paramID == Parameters::nameFreqBC) lfoBC.setFrequency(newValue);
-    if (paramID == Parameters::nameWaveformBC) lfoBC.setWaveform(roundToInt(newValue));
-    if (paramID == Parameters::nameAmountBC) BCModCtrl.setModAmount(newValue);
-    if (paramID == Parameters::nameBitCrush) BCModCtrl.setParameter(newValue);
-    if (paramID == Parameters::nameGainIn) GainIn.setTargetValue(Decibels::decibelsToGain(newValue));
-    if (paramID == Parameters::nameGainOut) GainOut.setTargetValue(Decibels::decibelsToGain(newValue));
+    // While a state is loading every parameter fires; they are applied in one pass once loading is done
+    if (!loadingState.load()) applyParameter(paramID, newValue);
 }
 
+void RalphAudioProcessor::applyAllParameters() {
+    const auto& params = getParameters();
+    for (int i = 0; i < params.size(); ++i)
+        if (auto* ranged = dynamic_cast<RangedAudioParameter*>(params[i]))
+            applyParameter(i, ranged->convertFrom0to1(ranged->getValue()));
+}
+
+void RalphAudioProcessor::applyParameter(const String& paramID, float newValue) {
+    if (auto* param = parameters.getParameter(paramID))
+        applyParameter(param->getParameterIndex(), newValue);
+}
+
+void RalphAudioProcessor::applyParameter(int index, float newValue) {
+    if (auto& setter = setters[(size_t) index].apply) setter(newValue);
+}
+
+// One setter per parameter, by getParameters() index, so applying a value never compares IDs. Parameters that
+// change latency or rebuild modulation routes are structural: a program switch applies those on the message thread.
+void RalphAudioProcessor::createSetters() {
+    setters.resize((size_t) getParameters().size());
+
+    auto add = [this](const String& paramID, bool structural, std::function<void(float)> apply) {
+        if (auto* param = parameters.getParameter(paramID))
+            setters[(size_t) param->getParameterIndex()] = { std::move(apply), structural };
+    };
+
+    add(Parameters::nameDryWetDS, false, [this](float v) { downSample.setDryWet(v * 0.01); });
+    add(Parameters::nameFreqDS, false, [this](float v) { lfoDS.setFrequency(v); });
+    add(Parameters::nameWaveformDS, false, [this](float v) { lfoDS.setWaveform(roundToInt(v)); });
+    add(Parameters::nameAmountDS, false, [this](float v) { matrix.setDepth(dsAmountRoute, v); });
+    add(Parameters::nameDownSample, false, [this](float v) { DSModCtrl.setParameter(v); });
+    add(Parameters::nameDryWetBC, false, [this](float v) { bitCrush.setDryWet(v * 0.01); });
+    add(Parameters::nameFreqBC, false, [this](float v) { lfoBC.setFrequency(v); });
+    add(Parameters::nameWaveformBC, false, [this](float v) { lfoBC.setWaveform(roundToInt(v)); });
+    add(Parameters::nameAmountBC, false, [this](float v) { matrix.setDepth(bcAmountRoute, v); });
+    add(Parameters::nameBitCrush, false, [this](float v) { BCModCtrl.setParameter(v); });
+    add(Parameters::nameGainIn, false, [this](float v) { GainIn.setTargetValue(Decibels::decibelsToGain(v)); });
+    add(Parameters::nameGainOut, false, [this](float v) { gainOutDecibels.store(v); });
+    add(Parameters::nameOversamplingBC, true, [this](float v) {
+        bitCrush.setOversampling(roundToInt(v));
+        setLatencySamples(getStageLatency());
+    });
+    add(Parameters::nameQuality, false, [this](float v) { qualityMode.store(roundToInt(v)); });
+    add(Parameters::nameStageOrder, false, [this](float v) { graph.setOrder(roundToInt(v)); });
+    add(Parameters::nameBypassBC, false, [this](float v) { graph.setBypassed(ProcessingGraph::crushStage, v > 0.5f); });
+    add(Parameters::nameBypassDS, false, [this](float v) { graph.setBypassed(ProcessingGraph::holdStage, v > 0.5f); });
+    add(Parameters::nameDryWet, false, [this](float v) { graph.setDryWet(v * 0.01); });
+    add(Parameters::nameSidechainAttack, false, [this](float v) { sidechainFollower.setAttack(v); });
+    add(Parameters::nameSidechainRelease, false, [this](float v) { sidechainFollower.setRelease(v); });
+    add(Parameters::nameSidechainDetector, false, [this](float v) { sidechainFollower.setDetector(roundToInt(v)); });
+    add(Parameters::nameBands, true, [this](float v) {
+        multiband.setNumBands(roundToInt(v) + 1);
+        setLatencySamples(getStageLatency());
+    });
+
+    for (int i = 0; i < Parameters::maxBands - 1; ++i)
+        add(Parameters::nameCrossover[i], false, [this, i](float v) { multiband.setCrossover(i, v); });
+    for (int band = 0; band < Parameters::maxBands; ++band) {
+        add(Parameters::nameBandBits[band], false, [this, band](float v) { multiband.setBandBits(band, v); });
+        add(Parameters::nameBandRate[band], false, [this, band](float v) { multiband.setBandRate(band, v); });
+    }
+
+    // Slots read all three of their parameters back from the tree, so they're rebuilt whichever one moved
+    for (int slot = 0; slot < Parameters::numModSlots; ++slot)
+        for (const auto* names : { Parameters::nameModSource, Parameters::nameModTarget, Parameters::nameModDepth })
+            add(names[slot], true, [this, slot](float) { applyModSlot(slot); });
+}
+
+// Slot depths are a percentage of the target's full range, so one knob means the same on every target
+void RalphAudioProcessor::applyModSlot(int slot) {
+    const auto source = roundToInt(parameters.getRawParameterValue(Parameters::nameModSource[slot])->load()) - 1;
+    const auto target = roundToInt(parameters.getRawParameterValue(Parameters::nameModTarget[slot])->load());
+    const auto depth = parameters.getRawParameterValue(Parameters::nameModDepth[slot])->load() * 0.01;
+
+    double span = 1.0;
+    if (target == ModulationMatrix::bitsTarget) span = Parameters::maxBitDepth - Parameters::minBitDepth;
+    if (target == ModulationMatrix::rateTarget) span = Parameters::maxSR - Parameters::minSR;
+    if (target == ModulationMatrix::gainOutTarget) span = Parameters::maxGain - Parameters::minGain;
+
+    matrix.setRoute(firstSlotRoute + slot, source, target, false);
+    matrix.setDepth(firstSlotRoute + slot, depth * span);
+}
+
+// Auto picks Eco while playing live and Render when the host bounces offline. Every switch is a flag flip:
+// the LFOs interpolate from their last value and BitCrush crossfades paths at constant latency.
+void RalphAudioProcessor::updateQualityTier() {
+    auto tier = qualityMode.load();
+    if (tier == Parameters::qualityAuto)
+        tier = isNonRealtime() ? Parameters::qualityRender : Parameters::qualityEco;
+
+    if (tier == currentQualityTier) return;
+    currentQualityTier = tier;
+
+    const bool eco = tier == Parameters::qualityEco;
+    lfoBC.setControlRate(eco);
+    lfoBC.setFastSine(eco);
+    lfoDS.setControlRate(eco);
+    lfoDS.setFastSine(eco);
+    bitCrush.setOversamplingAllowed(!eco);
+}
+
+// The decimated domain only pays off while the hold is audible and its rate, modulation included, sits below the
+// internal Nyquist frequency. It also needs a zero-latency chain, so engaging it never moves the reported latency.
+bool RalphAudioProcessor::wantsDecimation() const {
+    if (!domain.isAvailable() || multiband.isActive() || getStageLatency() != 0) return false;
+    if (bypassDSValue->load() > 0.5f) return false;
+
+    double rateCeiling = downSampleValue->load() + amountDSValue->load();
+    bool dryWetDSModulated = false, dryWetModulated = false;
+    for (int slot = 0; slot < Parameters::numModSlots; ++slot) {
+        const auto depth = std::abs(modDepthValues[slot]->load() * 0.01);
+        if (roundToInt(modSourceValues[slot]->load()) == 0 || depth == 0.0) continue;
+
+        const auto target = roundToInt(modTargetValues[slot]->load());
+        if (target == ModulationMatrix::rateTarget) rateCeiling += depth * (Parameters::maxSR - Parameters::minSR);
+        if (target == ModulationMatrix::dryWetDSTarget) dryWetDSModulated = true;
+        if (target == ModulationMatrix::dryWetTarget) dryWetModulated = true;
+    }
+
+    if (dryWetDSValue->load() <= 0.0f && !dryWetDSModulated) return false;
+    if (dryWetValue->load() <= 0.0f && !dryWetModulated) return false;
+    return rateCeiling < Parameters::maxSR / (2.0 * domain.getFactor());
+}
+
+// Multiband mode replaces the crush stage and has no latency of its own
+int RalphAudioProcessor::getStageLatency() const {
+    return multiband.isActive() ? 0 : bitCrush.getLatencySamples();
+}
+
+int RalphAudioProcessor::getNumPrograms() {
+    // Hosts expect at least one program, even when the bank couldn't be opened
+    return jmax(1, presetBank->getNumPresets());
+}
+
+int RalphAudioProcessor::getCurrentProgram() {
+    return currentProgram.load();
+}
+
+const String RalphAudioProcessor::getProgramName(int index) {
+    return presetBank->getName(index);
+}
+
+// A program switch publishes the new values to the host and editor with the listeners silenced, and applies
+// the structural ones (latency, modulation routes) right here on the message thread. The mapped record is the
+// snapshot: the audio thread picks up the remaining smoothed and atomic targets from it at its next block.
+// Every continuous target is smoothed, so the switch ramps instead of clicking.
+void RalphAudioProcessor::setCurrentProgram(int index) {
+    if (index == currentProgram.load()) return;
+    const auto* values = presetBank->getValues(index);
+    if (values == nullptr) return;
+    currentProgram.store(index);
+
+    loadingState.store(true);
+    const auto& params = getParameters();
+    const auto numValues = jmin(presetBank->getNumValues(), params.size());
+    for (int i = 0; i < numValues; ++i)
+        if (auto* ranged = dynamic_cast<RangedAudioParameter*>(params[i]))
+            ranged->setValueNotifyingHost(ranged->convertTo0to1(values[i]));
+    loadingState.store(false);
+
+    for (int i = 0; i < numValues; ++i)
+        if (setters[(size_t) i].structural)
+            if (auto* ranged = dynamic_cast<RangedAudioParameter*>(params[i]))
+                applyParameter(i, ranged->convertFrom0to1(ranged->convertTo0to1(values[i])));
+
+    pendingProgram.store(index);
+}
+
+void RalphAudioProcessor::applyProgram(int index) {
+    // Reads straight from the mapped record; setCurrentProgram has already paged it in
+    const auto* values = presetBank->getValues(index);
+    if (values == nullptr) return;
+
+    // Values go through the same normalised round trip the host saw, so a malformed bank is clamped,
+    // snapped and rounded exactly like the parameters it was published to
+    const auto& params = getParameters();
+    const auto numValues = jmin(presetBank->getNumValues(), (int) setters.size());
+    for (int i = 0; i < numValues; ++i)
+        if (!setters[(size_t) i].structural)
+            if (auto* ranged = dynamic_cast<RangedAudioParameter*>(params[i]))
+                applyParameter(i, ranged->convertFrom0to1(ranged->convertTo0to1(values[i])));
+}
 
 juce::AudioProcessorEditor* RalphAudioProcessor::createEditor() {
     return new WrappedRalphAudioProcessorEditor(*this, parameters);
 }
 
+// State layout: magic, version, parameter count, one plain float per parameter in getParameters() order, then
+// (from version 2) the current program. New parameters are only ever appended, so older blobs simply leave
+// them at their defaults.
 void RalphAudioProcessor::getStateInformation (juce::MemoryBlock& destData) {
-    auto state = parameters.copyState();
-    std::unique_ptr<XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    const auto& params = getParameters();
+    destData.setSize(0);
+    destData.ensureSize(stateHeaderSize + sizeof(float) * (size_t) params.size() + sizeof(int));
+
+    MemoryOutputStream stream(destData, false);
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateVersion);
+    stream.writeInt(params.size());
+    for (auto* param : params)
+        if (auto* ranged = dynamic_cast<RangedAudioParameter*>(param))
+            stream.writeFloat(ranged->convertFrom0to1(ranged->getValue()));
+    stream.writeInt(currentProgram.load());
 }
 
 void RalphAudioProcessor::setStateInformation (const void* data, int sizeInBytes) {
-    std::unique_ptr<XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-        if (xmlState.get() != nullptr)
-            if (xmlState->hasTagName(parameters.state.getType()))
-                parameters.replaceState(ValueTree::fromXml(*xmlState));
+    loadingState.store(true);
+
+    if (!readBinaryState(data, sizeInBytes)) {
+        std::unique_ptr<XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+            if (xmlState.get() != nullptr)
+                if (xmlState->hasTagName(parameters.state.getType()))
+                    parameters.replaceState(ValueTree::fromXml(*xmlState));
+    }
+
+    loadingState.store(false);
+    applyAllParameters();
+}
+
+bool RalphAudioProcessor::readBinaryState(const void* data, int sizeInBytes) {
+    if (data == nullptr || sizeInBytes < stateHeaderSize) return false;
+
+    MemoryInputStream stream(data, (size_t) sizeInBytes, false);
+    if (stream.readInt() != stateMagic) return false;
+    // Blobs from a newer layout can't be read index by index; they fall back like any other unknown data
+    const auto version = stream.readInt();
+    if (version < 1 || version > stateVersion) return false;
+
+    const auto& params = getParameters();
+    const auto numStored = stream.readInt();
+    if (numStored < 0 || (size_t) sizeInBytes < stateHeaderSize + sizeof(float) * (size_t) numStored) return false;
+
+    for (int i = 0; i < jmin(numStored, params.size()); ++i) {
+        const auto value = stream.readFloat();
+        if (auto* ranged = dynamic_cast<RangedAudioParameter*>(params[i]))
+            ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+    }
+    for (int i = params.size(); i < numStored; ++i)
+        stream.readFloat();
+
+    // Restoring the index keeps a host re-asserting the program after a session load from overwriting the state
+    if (version >= 2 && stream.getNumBytesRemaining() >= (int64) sizeof(int))
+        currentProgram.store(jmax(0, stream.readInt()));
+
+    return true;
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() {
@@ -4,7 +4,16 @@
 #include "Oscillator.h"
 #include "BitCrush.h"
 #include "DownSample.h"
+#include "ProcessingGraph.h"
 #include "ModulationControl.h"
+#include "ModulationMatrix.h"
+#include "EnvelopeFollower.h"
+#include "DecimatedDomain.h"
+#include "KernelGuard.h"
+#include "MeterSource.h"
+#include "SpectrumAnalyzer.h"
+#include "PresetBank.h"
+#include "Parameters.h"
 
 class RalphAudioProcessor : public juce::AudioProcessor, public AudioProcessorValueTreeState::Listener
 {
@@ -14,6 +23,7 @@ public:
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
@@ -26,17 +36,18 @@ public:
     bool isMidiEffect() const override { return false; }
     double getTailLengthSeconds() const override { return 0.0; }
 
-    int getNumPrograms() override { return 1; }
-    int getCurrentProgram() override { return 1; }
-    void setCurrentProgram (int index) override {}
-    const juce::String getProgramName (int index) override { return {}; }
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
     void changeProgramName (int index, const juce::String& newName) override {}
 
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
-    Atomic<float> envelopeIN;
-    Atomic<float> envelopeOUT;
+    MeterSource meterSourceIN;
+    MeterSource meterSourceOUT;
+    SpectrumAnalyzer analyzer;
 
 private:
     AudioProcessorValueTreeState parameters;
@@ -44,6 +55,20 @@ private:
     SmoothedValue<float, ValueSmoothingTypes::Linear> GainIn;
     SmoothedValue<float, ValueSmoothingTypes::Linear> GainOut;
     
+    DecimatedDomain domain;
+    bool processingDecimated = false;
+
+    // Read on the audio thread to decide whether the decimated domain engages
+    std::atomic<float>* downSampleValue = nullptr;
+    std::atomic<float>* amountDSValue = nullptr;
+    std::atomic<float>* dryWetDSValue = nullptr;
+    std::atomic<float>* dryWetValue = nullptr;
+    std::atomic<float>* bypassDSValue = nullptr;
+    std::atomic<float>* modSourceValues[Parameters::numModSlots] = {};
+    std::atomic<float>* modTargetValues[Parameters::numModSlots] = {};
+    std::atomic<float>* modDepthValues[Parameters::numModSlots] = {};
+    AudioBuffer<double> modulationLanes;
+
     BitCrush bitCrush;
     Oscillator lfoBC;
     AudioBuffer<double> BCMod;
@@ -53,8 +78,47 @@ private:
     Oscillator lfoDS;
     AudioBuffer<double> DSMod;
     ModulationControl DSModCtrl;
+
+    MultibandCrush multiband;
+    ProcessingGraph graph;
+
+    ModulationMatrix matrix;
+    EnvelopeFollower sidechainFollower;
+    static constexpr int bcAmountRoute = 0;
+    static constexpr int dsAmountRoute = 1;
+    static constexpr int firstSlotRoute = 2;
+    std::atomic<float> gainOutDecibels { Parameters::defaultGain };
     
+    std::atomic<int> qualityMode { Parameters::defaultQuality };
+    int currentQualityTier = -1;
+
+    SharedResourcePointer<PresetBank> presetBank;
+    std::atomic<int> currentProgram { 0 };
+    std::atomic<int> pendingProgram { -1 };
+
+    static constexpr int stateMagic = 0x48504c52; // "RLPH"
+    static constexpr int stateVersion = 2;
+    static constexpr int stateHeaderSize = 3 * sizeof(int);
+    std::atomic<bool> loadingState { false };
+
+    struct ParameterSetter {
+        std::function<void(float)> apply;
+        bool structural = false;
+    };
+    std::vector<ParameterSetter> setters;
+
+    bool readBinaryState(const void* data, int sizeInBytes);
+
     void parameterChanged(const String& paramID, float newValue) override;
+    void applyParameter(const String& paramID, float newValue);
+    void applyParameter(int index, float newValue);
+    void createSetters();
+    void applyAllParameters();
+    void updateQualityTier();
+    void applyModSlot(int slot);
+    void applyProgram(int index);
+    int getStageLatency() const;
+    bool wantsDecimation() const;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RalphAudioProcessor)
 };
@@ -0,0 +1,103 @@
+#include "PresetBank.h"
+#include "Parameters.h"
+
+namespace {
+    struct FactoryPreset {
+        const char* name;
+        std::initializer_list<std::pair<const String*, float>> values;
+    };
+
+    // Anything not listed keeps its default
+    const FactoryPreset factoryPresets[] = {
+        { "Init", {} },
+        { "8-Bit Console", { { &Parameters::nameBitCrush, 8.0f }, { &Parameters::nameDownSample, 22050.0f } } },
+        { "Telephone", { { &Parameters::nameBitCrush, 10.0f }, { &Parameters::nameDownSample, 6000.0f } } },
+        { "Wobble Crush", { { &Parameters::nameBitCrush, 6.0f }, { &Parameters::nameAmountBC, 4.0f }, { &Parameters::nameFreqBC, 0.5f }, { &Parameters::nameWaveformBC, 1.0f } } },
+        { "Stepped Rate", { { &Parameters::nameDownSample, 4000.0f }, { &Parameters::nameAmountDS, 6000.0f }, { &Parameters::nameFreqDS, 4.0f }, { &Parameters::nameWaveformDS, 5.0f } } },
+        { "Parallel Grit", { { &Parameters::nameBitCrush, 4.0f }, { &Parameters::nameDownSample, 11025.0f }, { &Parameters::nameDryWet, 40.0f } } },
+    };
+}
+
+File PresetBank::getBankFile() {
+    return File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("Ralph").getChildFile("Ralph.rlpb");
+}
+
+void PresetBank::open(const Array<AudioProcessorParameter*>& parameters) {
+    const ScopedLock lock(openLock);
+    if (opened) return;
+    opened = true;
+
+    const auto file = getBankFile();
+    if (map(file)) return;
+
+    // A newer build's bank is left alone instead of being replaced by this build's factory bank
+    if (newerBank) {
+        mappedFile.reset();
+        return;
+    }
+    if (writeFactoryBank(file, parameters))
+        map(file);
+}
+
+bool PresetBank::map(const File& file) {
+    mappedFile = std::make_unique<MemoryMappedFile>(file, MemoryMappedFile::readOnly);
+    const auto* data = static_cast<const char*>(mappedFile->getData());
+    const auto size = mappedFile->getSize();
+
+    int header[4] = {};
+    if (data == nullptr || size < (size_t) headerSize) return false;
+    std::memcpy(header, data, headerSize);
+    if (header[0] != bankMagic || header[2] < 1 || header[3] < 1) return false;
+    // A bank written by a newer build may lay its records out differently
+    if (header[1] < 1 || header[1] > bankVersion) {
+        newerBank = header[1] > bankVersion;
+        return false;
+    }
+
+    const auto stride = nameLength + sizeof(float) * (size_t) header[3];
+    if (size < headerSize + stride * (size_t) header[2]) return false;
+
+    numPresets = header[2];
+    numValues = header[3];
+    recordSize = stride;
+    records = data + headerSize;
+    return true;
+}
+
+bool PresetBank::writeFactoryBank(const File& file, const Array<AudioProcessorParameter*>& parameters) {
+    MemoryBlock block;
+    MemoryOutputStream stream(block, false);
+    stream.writeInt(bankMagic);
+    stream.writeInt(bankVersion);
+    stream.writeInt((int) std::size(factoryPresets));
+    stream.writeInt(parameters.size());
+
+    for (const auto& preset : factoryPresets) {
+        char name[nameLength] = {};
+        String(preset.name).copyToUTF8(name, nameLength);
+        stream.write(name, nameLength);
+
+        for (auto* param : parameters) {
+            auto* ranged = dynamic_cast<RangedAudioParameter*>(param);
+            float value = ranged != nullptr ? ranged->convertFrom0to1(ranged->getDefaultValue()) : 0.0f;
+            for (const auto& entry : preset.values)
+                if (ranged != nullptr && ranged->paramID == *entry.first)
+                    value = entry.second;
+            stream.writeFloat(value);
+        }
+    }
+    stream.flush();
+
+    return file.getParentDirectory().createDirectory() && file.replaceWithData(block.getData(), block.getSize());
+}
+
+String PresetBank::getName(int index) const {
+    if (!isPositiveAndBelow(index, numPresets)) return {};
+    const auto* name = records + recordSize * (size_t) index;
+    return String::fromUTF8(name, (int) strnlen(name, nameLength));
+}
+
+const float* PresetBank::getValues(int index) const {
+    if (!isPositiveAndBelow(index, numPresets)) return nullptr;
+    return reinterpret_cast<const float*>(records + recordSize * (size_t) index + nameLength);
+}
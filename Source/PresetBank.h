@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Read-only bank of fixed-layout preset records, memory-mapped from disk and shared by every instance
+// through a SharedResourcePointer. The first instance writes the factory bank if the file is missing.
+//
+// File layout (little-endian): magic "RLPB", version, record count, values per record,
+// then per record a zero-padded name of nameLength bytes followed by one float per parameter
+// in getParameters() order, in plain (not normalised) units.
+class PresetBank {
+public:
+    static constexpr int nameLength = 32;
+
+    PresetBank() = default;
+    ~PresetBank() = default;
+
+    void open(const Array<AudioProcessorParameter*>& parameters);
+
+    int getNumPresets() const { return numPresets; }
+    int getNumValues() const { return numValues; }
+    String getName(int index) const;
+    const float* getValues(int index) const;
+
+private:
+    static constexpr int bankMagic = 0x42504c52; // "RLPB"
+    static constexpr int bankVersion = 1;
+    static constexpr int headerSize = 4 * sizeof(int);
+
+    CriticalSection openLock;
+    bool opened = false;
+    bool newerBank = false;
+
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const char* records = nullptr;
+    int numPresets = 0;
+    int numValues = 0;
+    size_t recordSize = 0;
+
+    static File getBankFile();
+    static bool writeFactoryBank(const File& file, const Array<AudioProcessorParameter*>& parameters);
+    bool map(const File& file);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
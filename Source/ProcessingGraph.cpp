@@ -0,0 +1,137 @@
+#include "ProcessingGraph.h"
+
+ProcessingGraph::ProcessingGraph(BitCrush& crush, DownSample& hold, MultibandCrush& bands) :
+    bitCrush(crush),
+    downSample(hold),
+    multiband(bands),
+    plan(compile(crushThenHold))
+{
+}
+
+void ProcessingGraph::prepare(const dsp::ProcessSpec& spec, int maxLatencySamples) {
+    dryWet.prepare(spec.sampleRate);
+    dryDelay.setMaximumDelayInSamples(jmax(1, maxLatencySamples));
+    dryDelay.prepare(spec);
+    dryBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+}
+
+ProcessingGraph::Plan ProcessingGraph::compile(int order) {
+    Plan compiled {};
+    compiled.numSteps = numStages;
+    compiled.steps[0] = order == holdThenCrush ? holdStage : crushStage;
+    compiled.steps[1] = order == holdThenCrush ? crushStage : holdStage;
+    return compiled;
+}
+
+void ProcessingGraph::setOrder(int newOrder) {
+    plan.store(compile(newOrder));
+}
+
+void ProcessingGraph::setBypassed(Stage stage, bool shouldBeBypassed) {
+    if (stage == crushStage) bitCrush.setBypassed(shouldBeBypassed);
+    if (stage == holdStage) downSample.setBypassed(shouldBeBypassed);
+}
+
+void ProcessingGraph::setDryWet(float newValue) {
+    dryWet.setWetMixProportion(newValue);
+}
+
+void ProcessingGraph::setDryWetModulation(float offset) {
+    dryWet.setModulation(offset);
+}
+
+// Crush straight into hold: when the hold's dry signal is silent, only the captured samples are ever heard
+bool ProcessingGraph::canFuseCrushIntoHold(const AudioBuffer<float>& buffer) const {
+    return bitCrush.isDirect() && !downSample.isBypassed() && downSample.isFullyWet() && buffer.getNumChannels() <= 2;
+}
+
+void ProcessingGraph::processBlock(AudioBuffer<float>& buffer, AudioBuffer<double>& crushModulation, AudioBuffer<double>& holdModulation, int latencySamples) {
+    const auto numSamples = buffer.getNumSamples();
+
+    // Bit-identical stereo channels only need processing once. Delay lines and oversampling filters
+    // keep per-channel history, so this is limited to the zero-latency paths; the only state left
+    // is the held sample, which is copied across when the channels diverge again. The multiband
+    // crossovers filter per channel too, so they rule it out as well.
+    const bool mono = latencySamples == 0 && !multiband.isActive() && buffer.getNumChannels() == 2
+        && std::memcmp(buffer.getReadPointer(0), buffer.getReadPointer(1), sizeof(float) * (size_t) numSamples) == 0;
+
+    if (!mono) {
+        if (processedAsMono) downSample.copyChannelState(0, 1);
+        processedAsMono = false;
+        processChannels(buffer, crushModulation, holdModulation, latencySamples);
+        return;
+    }
+
+    processedAsMono = true;
+    AudioBuffer<float> firstChannel(buffer.getArrayOfWritePointers(), 1, numSamples);
+    processChannels(firstChannel, crushModulation, holdModulation, latencySamples);
+    FloatVectorOperations::copy(buffer.getWritePointer(1), buffer.getReadPointer(0), numSamples);
+}
+
+void ProcessingGraph::processChannels(AudioBuffer<float>& buffer, AudioBuffer<double>& crushModulation, AudioBuffer<double>& holdModulation, int latencySamples) {
+    const auto numSamples = buffer.getNumSamples();
+    const auto numCh = jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    const bool mixing = !dryWet.isFullyWet();
+
+    // With latency the delay line is fed on every block, fully wet or not, so opening the mix never
+    // replays audio left over from the last time it was mixed
+    if (latencySamples > 0) {
+        dryDelay.setDelay((float) latencySamples);
+        for (int ch = 0; ch < numCh; ++ch) {
+            auto* dry = dryBuffer.getWritePointer(ch);
+            const auto* input = buffer.getReadPointer(ch);
+            for (int smp = 0; smp < numSamples; ++smp) {
+                dryDelay.pushSample(ch, input[smp]);
+                dry[smp] = dryDelay.popSample(ch);
+            }
+        }
+    } else if (mixing) {
+        for (int ch = 0; ch < numCh; ++ch)
+            FloatVectorOperations::copy(dryBuffer.getWritePointer(ch), buffer.getReadPointer(ch), numSamples);
+    }
+
+    // Multiband mode takes the place of the crush and hold stages
+    if (multiband.isActive()) {
+        multiband.processBlock(buffer);
+        mixDry(buffer, mixing);
+        return;
+    }
+
+    // One plan per block: a reorder lands cleanly at the next block boundary
+    const auto current = plan.load();
+    for (int step = 0; step < current.numSteps; ++step) {
+        switch (current.steps[step]) {
+            case crushStage:
+                if (bitCrush.isBypassed()) break;
+                if (step + 1 < current.numSteps && current.steps[step + 1] == holdStage && canFuseCrushIntoHold(buffer)) {
+                    downSample.processCrushed(buffer, holdModulation, bitCrush, crushModulation);
+                    ++step;
+                    break;
+                }
+                bitCrush.processBlock(buffer, crushModulation);
+                break;
+            case holdStage:
+                if (!downSample.isBypassed()) downSample.processBlock(buffer, holdModulation);
+                break;
+            default:
+                jassertfalse;
+                break;
+        }
+    }
+
+    mixDry(buffer, mixing);
+}
+
+void ProcessingGraph::mixDry(AudioBuffer<float>& buffer, bool mixing) {
+    if (!mixing) return;
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto numCh = jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    auto bufferData = buffer.getArrayOfWritePointers();
+    float dryGain, wetGain;
+    for (int smp = 0; smp < numSamples; ++smp) {
+        dryWet.getNextGains(dryGain, wetGain);
+        for (int ch = 0; ch < numCh; ++ch)
+            bufferData[ch][smp] = dryBuffer.getSample(ch, smp) * dryGain + bufferData[ch][smp] * wetGain;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BitCrush.h"
+#include "DownSample.h"
+#include "MultibandCrush.h"
+#include "DryWetMix.h"
+
+// Runs the effect stages in place on the host buffer, in an order compiled into a flat plan.
+// The plan fits in one lock-free atomic, so reordering never blocks the audio thread.
+class ProcessingGraph {
+public:
+    enum Stage : uint8_t { crushStage = 0, holdStage, numStages };
+
+    static constexpr int crushThenHold = 0;
+    static constexpr int holdThenCrush = 1;
+
+    ProcessingGraph(BitCrush& crush, DownSample& hold, MultibandCrush& bands);
+    ~ProcessingGraph() = default;
+
+    void prepare(const dsp::ProcessSpec& spec, int maxLatencySamples);
+    void setOrder(int newOrder);
+    void setBypassed(Stage stage, bool shouldBeBypassed);
+    void setDryWet(float newValue);
+    void setDryWetModulation(float offset);
+    void processBlock(AudioBuffer<float>& buffer, AudioBuffer<double>& crushModulation, AudioBuffer<double>& holdModulation, int latencySamples);
+
+private:
+    // Padded to four bytes: atomics are only lock-free on every toolchain at power-of-two sizes
+    struct Plan {
+        uint8_t numSteps;
+        uint8_t steps[numStages];
+        uint8_t padding;
+    };
+    static_assert(sizeof(Plan) == 4, "the execution plan must stay a power-of-two size");
+    static_assert(std::atomic<Plan>::is_always_lock_free, "the execution plan must be swappable without locks");
+
+    BitCrush& bitCrush;
+    DownSample& downSample;
+    MultibandCrush& multiband;
+
+    std::atomic<Plan> plan;
+
+    // Global mix: the dry copy is only taken while it's audible, and delayed to match the stages' latency
+    DryWetMix dryWet;
+    dsp::DelayLine<float, dsp::DelayLineInterpolationTypes::None> dryDelay;
+    AudioBuffer<float> dryBuffer;
+
+    // Whether the last block ran on channel 0 alone, its result copied to channel 1
+    bool processedAsMono = false;
+
+    static Plan compile(int order);
+    bool canFuseCrushIntoHold(const AudioBuffer<float>& buffer) const;
+    void mixDry(AudioBuffer<float>& buffer, bool mixing);
+    void processChannels(AudioBuffer<float>& buffer, AudioBuffer<double>& crushModulation, AudioBuffer<double>& holdModulation, int latencySamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessingGraph)
+};
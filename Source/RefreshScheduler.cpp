@@ -0,0 +1,40 @@
+#include "RefreshScheduler.h"
+
+RefreshScheduler::RefreshScheduler(Component& owner) : owner(owner) {
+    owner.addComponentListener(this);
+    updateAttachment();
+}
+
+RefreshScheduler::~RefreshScheduler() {
+    owner.removeComponentListener(this);
+}
+
+void RefreshScheduler::addClient(Component& component, Client& client) {
+    registrations.push_back({&component, &client});
+}
+
+void RefreshScheduler::refresh() {
+    // Minimising keeps the peer (and its vblank) alive without any visibility callback
+    if (!owner.isShowing()) return;
+
+    for (auto& registration : registrations) {
+        const auto dirtyArea = registration.client->getDirtyArea();
+        if (!dirtyArea.isEmpty())
+            registration.component->repaint(dirtyArea);
+    }
+}
+
+void RefreshScheduler::updateAttachment() {
+    if (owner.isShowing())
+        vBlankAttachment = VBlankAttachment(&owner, [this] { refresh(); });
+    else
+        vBlankAttachment = VBlankAttachment();
+}
+
+void RefreshScheduler::componentVisibilityChanged(Component&) {
+    updateAttachment();
+}
+
+void RefreshScheduler::componentParentHierarchyChanged(Component&) {
+    updateAttachment();
+}
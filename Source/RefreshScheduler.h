@@ -0,0 +1,39 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Single per-editor refresh tick, driven by the display's vertical blank. Every frame each client reports
+// what changed and only those areas are repainted. The tick detaches while the owner is not showing.
+class RefreshScheduler : private ComponentListener {
+public:
+    class Client {
+    public:
+        virtual ~Client() = default;
+
+        // Area of the client (in its own coordinates) that changed since the last frame, or an empty rectangle
+        virtual Rectangle<int> getDirtyArea() = 0;
+    };
+
+    explicit RefreshScheduler(Component& owner);
+    ~RefreshScheduler() override;
+
+    void addClient(Component& component, Client& client);
+
+private:
+    struct Registration {
+        Component* component;
+        Client* client;
+    };
+
+    Component& owner;
+    std::vector<Registration> registrations;
+    VBlankAttachment vBlankAttachment;
+
+    void refresh();
+    void updateAttachment();
+
+    void componentVisibilityChanged(Component&) override;
+    void componentParentHierarchyChanged(Component&) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};
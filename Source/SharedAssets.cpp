@@ -0,0 +1,63 @@
+#include "SharedAssets.h"
+
+SharedAssets::SharedAssets() {
+    backgroundTexture = juce::ImageFileFormat::loadFrom(BinaryData::texture_jpg, BinaryData::texture_jpgSize);
+    atlas = loadAtlas();
+
+    glassTexture = region(AtlasIndex::glass);
+    screwImage = region(AtlasIndex::screw);
+    ralphWrite = region(AtlasIndex::ralph);
+    bitCrushWrite = region(AtlasIndex::bitCrush);
+    downSampleWrite = region(AtlasIndex::downSample);
+    amountWrite = region(AtlasIndex::amount);
+    dryWetWrite = region(AtlasIndex::dryWet);
+    frequencyWrite = region(AtlasIndex::frequency);
+    bitsWrite = region(AtlasIndex::bits);
+    hertzWrite = region(AtlasIndex::hertz);
+    zeroImage = region(AtlasIndex::zero);
+    hundredImage = region(AtlasIndex::hundred);
+    pointOOneImage = region(AtlasIndex::pointOOne);
+    sixtyImage = region(AtlasIndex::sixty);
+    fourImage = region(AtlasIndex::four);
+    threeImage = region(AtlasIndex::three);
+    tenKImage = region(AtlasIndex::tenK);
+    twentyFourImage = region(AtlasIndex::twentyFour);
+    fiveHundredImage = region(AtlasIndex::fiveHundred);
+    fourFourKImage = region(AtlasIndex::fourFourK);
+    triImage = region(AtlasIndex::tri);
+    sinImage = region(AtlasIndex::sin);
+    sawUpImage = region(AtlasIndex::sawUp);
+    sawDownImage = region(AtlasIndex::sawDown);
+    quadImage = region(AtlasIndex::quad);
+    shImage = region(AtlasIndex::sh);
+
+    littleKnob = region(AtlasIndex::littleKnob);
+    holeImage = region(AtlasIndex::hole);
+    knobWithoutPointer = region(AtlasIndex::knobWithoutPointer);
+    pointer = region(AtlasIndex::pointer);
+}
+
+Image SharedAssets::loadAtlas() {
+    // Header: "RATL", version, width, height; then zlib-compressed premultiplied pixels, already in PixelARGB layout
+    MemoryInputStream input(BinaryData::atlas_bin, BinaryData::atlas_binSize, false);
+    const bool validHeader = input.readInt() == (int) ByteOrder::littleEndianInt("RATL")
+                          && input.readInt() == AtlasIndex::version
+                          && input.readInt() == AtlasIndex::width
+                          && input.readInt() == AtlasIndex::height;
+    jassert(validHeader);
+    if (!validHeader) return Image(Image::ARGB, AtlasIndex::width, AtlasIndex::height, true);
+
+    Image image(Image::ARGB, AtlasIndex::width, AtlasIndex::height, false);
+    Image::BitmapData pixels(image, Image::BitmapData::writeOnly);
+    GZIPDecompressorInputStream pixelStream(input);
+    jassert(pixels.pixelStride == 4);
+
+    for (int y = 0; y < AtlasIndex::height; ++y)
+        pixelStream.read(pixels.getLinePointer(y), AtlasIndex::width * 4);
+
+    return image;
+}
+
+Image SharedAssets::region(const AtlasIndex::Region& r) const {
+    return atlas.getClippedImage({r.x, r.y, r.width, r.height});
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "AtlasIndex.h"
+
+// Editor images decoded once per process. Hold it through a SharedResourcePointer: the images are
+// loaded when the first editor opens and released when the last one closes.
+// Every PNG asset is a region of one pre-decoded atlas (see Tools/pack_atlas.py); only the JPEG texture is decoded.
+class SharedAssets {
+public:
+    SharedAssets();
+    ~SharedAssets() = default;
+
+    Image backgroundTexture, glassTexture, screwImage;
+    Image ralphWrite, bitCrushWrite, downSampleWrite;
+    Image bitsWrite, hertzWrite, frequencyWrite, amountWrite, dryWetWrite;
+    Image zeroImage, hundredImage, pointOOneImage, sixtyImage, threeImage, fourImage, tenKImage, twentyFourImage, fiveHundredImage, fourFourKImage;
+    Image triImage, sinImage, sawUpImage, sawDownImage, quadImage, shImage;
+
+    Image littleKnob, holeImage, knobWithoutPointer, pointer;
+
+private:
+    Image atlas;
+
+    Image loadAtlas();
+    Image region(const AtlasIndex::Region& r) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAssets)
+};
@@ -0,0 +1,161 @@
+#include "SpectrumAnalyzer.h"
+
+namespace {
+    constexpr int fifoCapacity = 8 * SpectrumAnalyzer::fftSize;
+    constexpr int analysisIntervalMs = 30;
+    constexpr float displayRelease = 0.8f;
+}
+
+SpectrumAnalyzer::Stream::Stream() : fifo(fifoCapacity) {}
+
+void SpectrumAnalyzer::Stream::allocate() {
+    fifoData.resize(fifoCapacity);
+    history.resize(fftSize);
+    fftData.resize(2 * fftSize);
+}
+
+void SpectrumAnalyzer::Stream::push(const AudioBuffer<float>& buffer, int numSamples) {
+    // Drops the block if the analysis thread is behind, rather than ever waiting on it
+    if (buffer.getNumChannels() == 0 || fifo.getFreeSpace() < numSamples) return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    const auto* source = buffer.getReadPointer(0);
+    std::memcpy(fifoData.data() + start1, source, sizeof(float) * size1);
+    std::memcpy(fifoData.data() + start2, source + size1, sizeof(float) * size2);
+    fifo.finishedWrite(size1 + size2);
+}
+
+bool SpectrumAnalyzer::Stream::pull() {
+    const auto numReady = fifo.getNumReady();
+    if (numReady == 0) return false;
+
+    // Keeps the most recent fftSize samples in history
+    const auto numNew = jmin(numReady, fftSize);
+    std::memmove(history.data(), history.data() + numNew, sizeof(float) * (fftSize - numNew));
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+    auto* destination = history.data() + fftSize - numNew;
+    int toSkip = numReady - numNew;
+
+    for (auto [start, size] : { std::pair<int, int>(start1, size1), std::pair<int, int>(start2, size2) }) {
+        const auto skipped = jmin(toSkip, size);
+        toSkip -= skipped;
+        std::memcpy(destination, fifoData.data() + start + skipped, sizeof(float) * (size - skipped));
+        destination += size - skipped;
+    }
+
+    fifo.finishedRead(size1 + size2);
+    return true;
+}
+
+void SpectrumAnalyzer::Stream::discard() {
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+    fifo.finishedRead(size1 + size2);
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer() : Thread("Ralph spectrum analyzer") {}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+    stop();
+}
+
+void SpectrumAnalyzer::start() {
+    // Buffers are allocated the first time an editor opens and then kept: the audio thread may still be
+    // finishing a push when the analyzer stops, so they must outlive every stop()
+    if (fft == nullptr) {
+        input.allocate();
+        output.allocate();
+        fft = std::make_unique<dsp::FFT>(fftOrder);
+        window = std::make_unique<dsp::WindowingFunction<float>>(fftSize, dsp::WindowingFunction<float>::hann, false);
+    }
+
+    // Publishes the buffers to the audio thread; stale samples are dropped by the analysis thread, the FIFO's
+    // only reader, since an audio callback may still be pushing
+    active.store(true);
+    startThread(Thread::Priority::low);
+}
+
+void SpectrumAnalyzer::stop() {
+    active.store(false);
+    stopThread(1000);
+}
+
+void SpectrumAnalyzer::pushInput(const AudioBuffer<float>& buffer, int numSamples) {
+    if (active.load(std::memory_order_acquire)) input.push(buffer, numSamples);
+}
+
+void SpectrumAnalyzer::pushOutput(const AudioBuffer<float>& buffer, int numSamples) {
+    if (active.load(std::memory_order_acquire)) output.push(buffer, numSamples);
+}
+
+bool SpectrumAnalyzer::getSpectra(float* inputBins, float* outputBins, int& lastVersion) {
+    const auto currentVersion = version.load();
+    if (currentVersion == lastVersion) return false;
+
+    const SpinLock::ScopedLockType lock(displayLock);
+    std::copy(std::begin(displayInput), std::end(displayInput), inputBins);
+    std::copy(std::begin(displayOutput), std::end(displayOutput), outputBins);
+    lastVersion = currentVersion;
+    return true;
+}
+
+void SpectrumAnalyzer::run() {
+    input.discard();
+    output.discard();
+
+    while (!threadShouldExit()) {
+        if (binSampleRate != sampleRate.load())
+            updateBinRanges();
+
+        const bool newInput = input.pull();
+        const bool newOutput = output.pull();
+        if (newInput) analyse(input);
+        if (newOutput) analyse(output);
+
+        if (newInput || newOutput) {
+            const SpinLock::ScopedLockType lock(displayLock);
+            std::copy(std::begin(input.bins), std::end(input.bins), displayInput);
+            std::copy(std::begin(output.bins), std::end(output.bins), displayOutput);
+            ++version;
+        }
+
+        wait(analysisIntervalMs);
+    }
+}
+
+void SpectrumAnalyzer::updateBinRanges() {
+    // Log-spaced display bins from minFrequency to Nyquist, each covering at least one FFT bin
+    binSampleRate = sampleRate.load();
+    const auto nyquist = static_cast<float>(binSampleRate * 0.5);
+    const auto binWidth = static_cast<float>(binSampleRate / fftSize);
+
+    for (int b = 0; b <= numDisplayBins; ++b) {
+        const auto frequency = minFrequency * std::pow(nyquist / minFrequency, b / static_cast<float>(numDisplayBins));
+        binStart[b] = jlimit(1, fftSize / 2, roundToInt(frequency / binWidth));
+    }
+}
+
+void SpectrumAnalyzer::analyse(Stream& stream) {
+    std::copy(stream.history.begin(), stream.history.end(), stream.fftData.begin());
+    std::fill(stream.fftData.begin() + fftSize, stream.fftData.end(), 0.0f);
+    window->multiplyWithWindowingTable(stream.fftData.data(), fftSize);
+    fft->performFrequencyOnlyForwardTransform(stream.fftData.data(), true);
+
+    // A full-scale sine through the Hann window peaks at fftSize / 4
+    const auto normalisation = 4.0f / fftSize;
+
+    for (int b = 0; b < numDisplayBins; ++b) {
+        const auto first = binStart[b];
+        const auto last = jmax(first + 1, binStart[b + 1]);
+        float magnitude = 0.0f;
+        for (int i = first; i < last && i <= fftSize / 2; ++i)
+            magnitude = jmax(magnitude, stream.fftData[(size_t) i]);
+
+        const auto dB = Decibels::gainToDecibels(magnitude * normalisation, dBFloor);
+        const auto level = jmap(jlimit(dBFloor, 0.0f, dB), dBFloor, 0.0f, 0.0f, 1.0f);
+        stream.bins[b] = jmax(level, stream.bins[b] * displayRelease);
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Input and output spectra for the editor overlay. The audio thread only copies channel 0 into preallocated
+// lock-free FIFOs; a background thread runs the windowed FFTs and decimates them to a few log-spaced bins.
+// Nothing is allocated, copied or computed until an editor first starts the analyzer.
+class SpectrumAnalyzer : private Thread {
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numDisplayBins = 96;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float dBFloor = -96.0f;
+
+    SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
+
+    // Message thread
+    void start();
+    void stop();
+
+    // Audio thread
+    void setSampleRate(double newSampleRate) { sampleRate.store(newSampleRate); }
+    void pushInput(const AudioBuffer<float>& buffer, int numSamples);
+    void pushOutput(const AudioBuffer<float>& buffer, int numSamples);
+
+    // UI thread: copies the latest spectra (levels between 0 and 1) if they changed since lastVersion
+    bool getSpectra(float* inputBins, float* outputBins, int& lastVersion);
+
+private:
+    struct Stream {
+        Stream();
+        void allocate();
+        void push(const AudioBuffer<float>& buffer, int numSamples);
+        bool pull();
+        void discard();
+
+        AbstractFifo fifo;
+        std::vector<float> fifoData;
+        std::vector<float> history;
+        std::vector<float> fftData;
+        float bins[numDisplayBins] = {};
+    };
+
+    std::atomic<bool> active { false };
+    std::atomic<double> sampleRate { 44100.0 };
+    double binSampleRate = 0.0;
+    int binStart[numDisplayBins + 1] = {};
+
+    Stream input, output;
+    std::unique_ptr<dsp::FFT> fft;
+    std::unique_ptr<dsp::WindowingFunction<float>> window;
+
+    SpinLock displayLock;
+    float displayInput[numDisplayBins] = {};
+    float displayOutput[numDisplayBins] = {};
+    std::atomic<int> version { 0 };
+
+    void run() override;
+    void updateBinRanges();
+    void analyse(Stream& stream);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
@@ -0,0 +1,37 @@
+#include "SpectrumOverlay.h"
+
+SpectrumOverlay::SpectrumOverlay(SpectrumAnalyzer& analyzer) : analyzer(analyzer) {
+    setInterceptsMouseClicks(false, false);
+    analyzer.start();
+}
+
+SpectrumOverlay::~SpectrumOverlay() {
+    analyzer.stop();
+}
+
+void SpectrumOverlay::paint(Graphics& g) {
+    drawSpectrum(g, inputBins, Colours::grey);
+    drawSpectrum(g, outputBins, Colours::lightblue);
+}
+
+void SpectrumOverlay::drawSpectrum(Graphics& g, const float* bins, Colour colour) {
+    const auto W = static_cast<float>(getWidth());
+    const auto H = static_cast<float>(getHeight());
+    const auto binWidth = W / (SpectrumAnalyzer::numDisplayBins - 1);
+
+    Path spectrum;
+    spectrum.startNewSubPath(0.0f, H);
+    for (int b = 0; b < SpectrumAnalyzer::numDisplayBins; ++b)
+        spectrum.lineTo(b * binWidth, H - bins[b] * H);
+    spectrum.lineTo(W, H);
+    spectrum.closeSubPath();
+
+    g.setColour(colour.withAlpha(0.15f));
+    g.fillPath(spectrum);
+    g.setColour(colour.withAlpha(0.6f));
+    g.strokePath(spectrum, PathStrokeType(1.0f));
+}
+
+Rectangle<int> SpectrumOverlay::getDirtyArea() {
+    return analyzer.getSpectra(inputBins, outputBins, lastVersion) ? getLocalBounds() : Rectangle<int>();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "RefreshScheduler.h"
+#include "SpectrumAnalyzer.h"
+
+class SpectrumOverlay : public Component, public RefreshScheduler::Client {
+public:
+    SpectrumOverlay(SpectrumAnalyzer& analyzer);
+    ~SpectrumOverlay() override;
+
+    void paint(Graphics& g) override;
+    Rectangle<int> getDirtyArea() override;
+
+private:
+    SpectrumAnalyzer& analyzer;
+    float inputBins[SpectrumAnalyzer::numDisplayBins] = {};
+    float outputBins[SpectrumAnalyzer::numDisplayBins] = {};
+    int lastVersion = -1;
+
+    void drawSpectrum(Graphics& g, const float* bins, Colour colour);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumOverlay)
+};
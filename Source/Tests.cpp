@@ -0,0 +1,356 @@
+// Unit tests, compiled only when RALPH_TESTS=1 is added to the preprocessor definitions.
+// Run them through juce::UnitTestRunner::runTestsInCategory("Ralph"); failures are written to the test log.
+
+#include "PluginProcessor.h"
+#include "ProcessingGraph.h"
+#include "MultibandCrush.h"
+#include "Parameters.h"
+
+#if RALPH_TESTS
+
+namespace {
+    RangedAudioParameter* findParameter(AudioProcessor& processor, const String& paramID) {
+        for (auto* param : processor.getParameters())
+            if (auto* ranged = dynamic_cast<RangedAudioParameter*>(param))
+                if (ranged->paramID == paramID)
+                    return ranged;
+        return nullptr;
+    }
+
+    void setParameter(AudioProcessor& processor, const String& paramID, float value) {
+        if (auto* ranged = findParameter(processor, paramID))
+            ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+    }
+
+    float getParameter(AudioProcessor& processor, const String& paramID) {
+        auto* ranged = findParameter(processor, paramID);
+        return ranged != nullptr ? ranged->convertFrom0to1(ranged->getValue()) : 0.0f;
+    }
+
+    void fillWithNoise(AudioBuffer<float>& buffer, int channel, Random& random) {
+        for (int smp = 0; smp < buffer.getNumSamples(); ++smp)
+            buffer.setSample(channel, smp, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    // A crush and hold pair behind a processing graph, prepared the way the processor prepares them
+    struct Chain {
+        BitCrush crush;
+        DownSample hold;
+        MultibandCrush bands;
+        ProcessingGraph graph { crush, hold, bands };
+
+        Chain(double sampleRate, int blockSize, int numChannels, float crushMix, float holdMix) {
+            crush.setDryWet(crushMix);
+            hold.setDryWet(holdMix);
+            const dsp::ProcessSpec spec {sampleRate, (uint32) blockSize, (uint32) numChannels};
+            crush.prepare(spec);
+            bands.prepare(spec, Parameters::maxSR);
+            hold.prepareToPlay(sampleRate, Parameters::maxSR);
+            graph.prepare(spec, crush.getMaxLatencySamples());
+        }
+    };
+}
+
+class CrossoverLimitTest : public UnitTest {
+public:
+    CrossoverLimitTest() : UnitTest("Multiband crossover limits", "Ralph") {}
+
+    void runTest() override {
+        const float extremes[] = {Parameters::minCrossover, Parameters::maxCrossover};
+        const double sampleRates[] = {44100.0, 48000.0, 96000.0};
+
+        beginTest("Crossovers stay ascending and below Nyquist at the parameter extremes");
+        for (auto sampleRate : sampleRates) {
+            for (int numCrossovers = 1; numCrossovers < MultibandCrush::maxBands; ++numCrossovers) {
+                // Every combination of minimum and maximum crossover values
+                for (int combination = 0; combination < (1 << numCrossovers); ++combination) {
+                    float frequencies[MultibandCrush::maxBands - 1];
+                    for (int i = 0; i < numCrossovers; ++i)
+                        frequencies[i] = extremes[(combination >> i) & 1];
+
+                    MultibandCrush::limitCrossovers(frequencies, numCrossovers, sampleRate);
+
+                    for (int i = 0; i < numCrossovers; ++i) {
+                        expect(frequencies[i] >= Parameters::minCrossover);
+                        expect(frequencies[i] <= (float) (sampleRate * 0.45));
+                        if (i > 0)
+                            expect(frequencies[i] >= frequencies[i - 1] * 1.149f);
+                    }
+                }
+            }
+        }
+
+        beginTest("Four bands with every crossover at its maximum");
+        for (auto sampleRate : sampleRates) {
+            MultibandCrush multiband;
+            constexpr int blockSize = 256;
+            multiband.prepare({sampleRate, (uint32) blockSize, 2}, Parameters::maxSR);
+            multiband.setNumBands(MultibandCrush::maxBands);
+            for (int i = 0; i < MultibandCrush::maxBands - 1; ++i)
+                multiband.setCrossover(i, Parameters::maxCrossover);
+
+            AudioBuffer<float> buffer(2, blockSize);
+            Random random(1234);
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int smp = 0; smp < blockSize; ++smp)
+                    buffer.setSample(ch, smp, random.nextFloat() * 2.0f - 1.0f);
+
+            multiband.processBlock(buffer);
+
+            bool finite = true;
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int smp = 0; smp < blockSize; ++smp)
+                    finite = finite && std::isfinite(buffer.getSample(ch, smp));
+            expect(finite, "non-finite output at " + String(sampleRate) + " Hz");
+        }
+    }
+};
+
+static CrossoverLimitTest crossoverLimitTest;
+
+class StateTest : public UnitTest {
+public:
+    StateTest() : UnitTest("State save and restore", "Ralph") {}
+
+    void runTest() override {
+        const std::pair<String, float> edited[] = {
+            {Parameters::nameBitCrush, 6.0f},
+            {Parameters::nameDownSample, 3000.0f},
+            {Parameters::nameDryWetDS, 40.0f},
+            {Parameters::nameWaveformBC, 3.0f},
+            {Parameters::nameStageOrder, 1.0f}
+        };
+
+        beginTest("Binary state round trip");
+        {
+            RalphAudioProcessor source, destination;
+            for (const auto& [paramID, value] : edited)
+                setParameter(source, paramID, value);
+
+            MemoryBlock state;
+            source.getStateInformation(state);
+            destination.setStateInformation(state.getData(), (int) state.getSize());
+
+            for (auto* param : source.getParameters())
+                if (auto* ranged = dynamic_cast<RangedAudioParameter*>(param))
+                    expectWithinAbsoluteError(getParameter(destination, ranged->paramID), getParameter(source, ranged->paramID), 1.0e-3f, ranged->paramID);
+        }
+
+        beginTest("Legacy XML state still loads");
+        {
+            // The layout written before the binary blob: the value tree state as XML, one PARAM child per parameter
+            XmlElement xml("PARAMS");
+            for (const auto& [paramID, value] : edited) {
+                auto* child = xml.createNewChildElement("PARAM");
+                child->setAttribute("id", paramID);
+                child->setAttribute("value", value);
+            }
+
+            MemoryBlock state;
+            AudioProcessor::copyXmlToBinary(xml, state);
+
+            RalphAudioProcessor processor;
+            processor.setStateInformation(state.getData(), (int) state.getSize());
+            for (const auto& [paramID, value] : edited)
+                expectWithinAbsoluteError(getParameter(processor, paramID), value, 1.0e-3f, paramID);
+        }
+
+        beginTest("State from a newer version is rejected");
+        {
+            RalphAudioProcessor source, destination;
+            for (const auto& [paramID, value] : edited)
+                setParameter(source, paramID, value);
+
+            MemoryBlock state;
+            source.getStateInformation(state);
+            // The version follows the magic number
+            auto* version = static_cast<int*>(state.getData()) + 1;
+            *version = ByteOrder::swapIfBigEndian(ByteOrder::swapIfBigEndian(*version) + 1);
+
+            std::vector<float> before;
+            for (auto* param : destination.getParameters())
+                before.push_back(param->getValue());
+
+            destination.setStateInformation(state.getData(), (int) state.getSize());
+
+            const auto& params = destination.getParameters();
+            for (int i = 0; i < params.size(); ++i)
+                expectEquals(params[i]->getValue(), before[(size_t) i]);
+        }
+    }
+};
+
+static StateTest stateTest;
+
+class MonoPathTest : public UnitTest {
+public:
+    MonoPathTest() : UnitTest("Mono path matches the stereo path", "Ralph") {}
+
+    void runTest() override {
+        constexpr double sampleRate = 44100.0;
+        constexpr int blockSize = 128;
+        constexpr int numBlocks = 64;
+
+        beginTest("Identical channels give the same output either way");
+        // The reference runs a third, unrelated channel, so it never takes the mono path. Partly wet
+        // stages keep both graphs off the fused crush and hold, which the reference can't take either.
+        Chain mono(sampleRate, blockSize, 2, 0.8f, 0.6f);
+        Chain stereo(sampleRate, blockSize, 3, 0.8f, 0.6f);
+
+        AudioBuffer<float> monoBuffer(2, blockSize), stereoBuffer(3, blockSize);
+        AudioBuffer<double> crushModulation(1, blockSize), holdModulation(1, blockSize);
+        Random random(1234);
+        bool matches = true;
+
+        for (int block = 0; block < numBlocks; ++block) {
+            // Runs of identical blocks with distinct ones in between, so the held state is handed back and forth
+            fillWithNoise(monoBuffer, 0, random);
+            if (block % 8 < 5) monoBuffer.copyFrom(1, 0, monoBuffer, 0, 0, blockSize);
+            else fillWithNoise(monoBuffer, 1, random);
+
+            for (int ch = 0; ch < 2; ++ch)
+                stereoBuffer.copyFrom(ch, 0, monoBuffer, ch, 0, blockSize);
+            fillWithNoise(stereoBuffer, 2, random);
+
+            for (int smp = 0; smp < blockSize; ++smp) {
+                crushModulation.setSample(0, smp, 4.0 + (block % 5));
+                holdModulation.setSample(0, smp, 3000.0 + 200.0 * smp);
+            }
+
+            for (auto* chain : {&mono, &stereo}) {
+                chain->crush.setDryWetModulation(0.0f);
+                chain->hold.setDryWetModulation(0.0f);
+                chain->graph.setDryWetModulation(0.0f);
+            }
+
+            mono.graph.processBlock(monoBuffer, crushModulation, holdModulation, 0);
+            stereo.graph.processBlock(stereoBuffer, crushModulation, holdModulation, 0);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int smp = 0; smp < blockSize; ++smp)
+                    matches = matches && monoBuffer.getSample(ch, smp) == stereoBuffer.getSample(ch, smp);
+        }
+
+        expect(matches, "mono and stereo outputs differ");
+    }
+};
+
+static MonoPathTest monoPathTest;
+
+class FusedCrushHoldTest : public UnitTest {
+public:
+    FusedCrushHoldTest() : UnitTest("Fused crush and hold", "Ralph") {}
+
+    void runTest() override {
+        constexpr double sampleRate = 44100.0;
+        constexpr int blockSize = 128;
+        constexpr int numBlocks = 64;
+
+        for (int factor : {1, 2}) {
+            beginTest("Bit-identical to the separate stages, hold step " + String(factor));
+            // A fully wet hold lets the graph fuse the crush into it; the reference runs the stages one after the other
+            Chain fused(sampleRate, blockSize, 2, 0.7f, 1.0f);
+            Chain separate(sampleRate, blockSize, 2, 0.7f, 1.0f);
+            fused.hold.setDecimationFactor(factor);
+            separate.hold.setDecimationFactor(factor);
+
+            AudioBuffer<float> fusedBuffer(2, blockSize), separateBuffer(2, blockSize);
+            AudioBuffer<double> crushModulation(1, blockSize), holdModulation(1, blockSize);
+            Random random(1234);
+            bool matches = true;
+
+            for (int block = 0; block < numBlocks; ++block) {
+                for (int ch = 0; ch < 2; ++ch)
+                    fillWithNoise(fusedBuffer, ch, random);
+                separateBuffer.makeCopyOf(fusedBuffer, true);
+
+                for (int smp = 0; smp < blockSize; ++smp) {
+                    crushModulation.setSample(0, smp, 3.0 + 0.1 * ((block * blockSize + smp) % 200));
+                    holdModulation.setSample(0, smp, 2000.0 + 150.0 * ((block + smp) % 64));
+                }
+
+                for (auto* chain : {&fused, &separate}) {
+                    chain->crush.setDryWetModulation(0.0f);
+                    chain->hold.setDryWetModulation(0.0f);
+                    chain->graph.setDryWetModulation(0.0f);
+                }
+
+                fused.graph.processBlock(fusedBuffer, crushModulation, holdModulation, 0);
+                separate.crush.processBlock(separateBuffer, crushModulation);
+                separate.hold.processBlock(separateBuffer, holdModulation);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int smp = 0; smp < blockSize; ++smp)
+                        matches = matches && fusedBuffer.getSample(ch, smp) == separateBuffer.getSample(ch, smp);
+            }
+
+            expect(matches, "fused and separate outputs differ");
+        }
+    }
+};
+
+static FusedCrushHoldTest fusedCrushHoldTest;
+
+class DecimatedDomainContinuityTest : public UnitTest {
+public:
+    DecimatedDomainContinuityTest() : UnitTest("Decimated domain engage and disengage", "Ralph") {}
+
+    void runTest() override {
+        beginTest("Switching the domain at 96 kHz doesn't click");
+
+        // A hold rate of 4 kHz runs decimated at 96 kHz, 12 kHz doesn't; the steady runs set the bound for the switching one
+        const auto steadyEngaged = largestStep({4000.0f});
+        const auto steadyHostRate = largestStep({12000.0f});
+        const auto switching = largestStep({4000.0f, 12000.0f});
+
+        logMessage("largest step: decimated " + String(steadyEngaged, 4) + ", host rate " + String(steadyHostRate, 4) + ", switching " + String(switching, 4));
+        expectLessOrEqual(switching, 1.5f * jmax(steadyEngaged, steadyHostRate) + 0.01f);
+    }
+
+private:
+    // Runs a 100 Hz sine through the processor, cycling the hold rate through the given values every
+    // few blocks, and returns the largest difference between consecutive output samples (infinite on non-finite output)
+    static float largestStep(std::initializer_list<float> holdRates) {
+        constexpr double sampleRate = 96000.0;
+        constexpr int blockSize = 256;
+        constexpr int blocksPerRate = 12;
+        constexpr int numBlocks = 96;
+
+        RalphAudioProcessor processor;
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        AudioBuffer<float> buffer(2, blockSize);
+        MidiBuffer midi;
+        const std::vector<float> rates(holdRates);
+        double phase = 0.0;
+        float previous = 0.0f, largest = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block) {
+            setParameter(processor, Parameters::nameDownSample, rates[(size_t) (block / blocksPerRate) % rates.size()]);
+
+            for (int smp = 0; smp < blockSize; ++smp) {
+                const auto value = 0.5f * (float) std::sin(phase);
+                phase += MathConstants<double>::twoPi * 100.0 / sampleRate;
+                buffer.setSample(0, smp, value);
+                buffer.setSample(1, smp, value);
+            }
+
+            processor.processBlock(buffer, midi);
+
+            for (int smp = 0; smp < blockSize; ++smp) {
+                const auto value = buffer.getSample(0, smp);
+                if (!std::isfinite(value)) return std::numeric_limits<float>::infinity();
+                // The first blocks only settle the smoothing and the filters
+                if (block >= 2) largest = jmax(largest, std::abs(value - previous));
+                previous = value;
+            }
+        }
+
+        return largest;
+    }
+};
+
+static DecimatedDomainContinuityTest decimatedDomainContinuityTest;
+
+#endif
@@ -1,12 +1,8 @@
 #include "TimedSlider.h"
 
-TimedSlider::TimedSlider() : lastUpdateTimestamp(Time::currentTimeMillis()), creationTimestamp(Time::currentTimeMillis()), drawable(false) {
-    startTimerHz(4);
-}
+TimedSlider::TimedSlider() : lastUpdateTimestamp(Time::currentTimeMillis()), creationTimestamp(Time::currentTimeMillis()), drawable(false) {}
 
-TimedSlider::~TimedSlider() {
-    stopTimer();
-}
+TimedSlider::~TimedSlider() {}
 
 void TimedSlider::setValueWithTimeCheck(double newValue) {
     int64 currentTime = Time::currentTimeMillis();
@@ -32,6 +28,9 @@ bool TimedSlider::isDrawable() const {
     return drawable;
 }
 
-void TimedSlider::timerCallback() {
-    repaint();
+Rectangle<int> TimedSlider::getDirtyArea() {
+    // Value changes repaint through Slider itself; only the value overlay appearing or disappearing needs a frame
+    const bool wasDrawable = drawable;
+    setValueWithTimeCheck(getValue());
+    return drawable != wasDrawable ? getLocalBounds() : Rectangle<int>();
 }
@@ -1,18 +1,18 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "RefreshScheduler.h"
 
-class TimedSlider : public Slider, private Timer {
+class TimedSlider : public Slider, public RefreshScheduler::Client {
 public:
     TimedSlider();
     ~TimedSlider() override;
 
     void setValueWithTimeCheck(double newValue);
     bool isDrawable() const;
+    Rectangle<int> getDirtyArea() override;
 
 private:
-    void timerCallback() override;
-
     double lastValidValue = 0.0;
     int64 lastUpdateTimestamp = 0;
     int64 creationTimestamp = 0;
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Packs the editor's PNG assets into one pre-decoded atlas.
+
+Writes Source/atlas.bin (zlib-compressed, premultiplied BGRA pixels in JUCE's little-endian
+PixelARGB layout) and Source/AtlasIndex.h (constexpr sub-rectangles). Run it whenever an
+image in ASSETS changes, then re-save Ralph.jucer so BinaryData picks up the new atlas.
+
+Only the standard library is used, so the decoder covers just what the assets need:
+8-bit, non-interlaced PNGs of every colour type.
+"""
+
+import os
+import struct
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "Source")
+
+# Atlas region name -> PNG file in Source/
+ASSETS = [
+    ("littleKnob", "littleKnob.png"),
+    ("ralph", "ralph.png"),
+    ("hole", "hole.png"),
+    ("bitCrush", "bitCrush.png"),
+    ("downSample", "downSample.png"),
+    ("glass", "glass.png"),
+    ("knobWithoutPointer", "knobWithoutPointer.png"),
+    ("frequency", "frequency.png"),
+    ("dryWet", "dryWet.png"),
+    ("amount", "amount.png"),
+    ("bits", "bits.png"),
+    ("hertz", "hertz.png"),
+    ("screw", "screw.png"),
+    ("pointer", "pointer.png"),
+    ("sin", "sin.png"),
+    ("fourFourK", "fourFourK.png"),
+    ("pointOOne", "pointOOne.png"),
+    ("fiveHundred", "fiveHundred.png"),
+    ("hundred", "hundred.png"),
+    ("twentyFour", "twentyFour.png"),
+    ("tenK", "tenK.png"),
+    ("tri", "tri.png"),
+    ("quad", "quad.png"),
+    ("sawDown", "sawDown.png"),
+    ("sawUp", "sawUp.png"),
+    ("sh", "sh.png"),
+    ("sixty", "sixty.png"),
+    ("four", "four.png"),
+    ("zero", "zero.png"),
+    ("three", "three.png"),
+]
+
+ATLAS_WIDTH = 1024
+PADDING = 1
+MAGIC = b"RATL"
+VERSION = 1
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def decode_png(path):
+    """Returns (width, height, rows) with rows as lists of (r, g, b, a) straight-alpha tuples."""
+    with open(path, "rb") as f:
+        data = f.read()
+    assert data[:8] == b"\x89PNG\r\n\x1a\n", path
+
+    pos, idat, palette, trns = 8, b"", None, None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, colour, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            assert depth == 8 and interlace == 0, path
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, length, 3)]
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[colour]
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    previous = bytearray(stride)
+    rows = []
+
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - channels] if i >= channels else 0
+            up = previous[i]
+            upper_left = previous[i - channels] if i >= channels else 0
+            if filter_type == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif filter_type == 4:
+                line[i] = (line[i] + paeth(left, up, upper_left)) & 0xFF
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            p = line[x * channels:(x + 1) * channels]
+            if colour == 0:
+                pixels.append((p[0], p[0], p[0], 255))
+            elif colour == 2:
+                pixels.append((p[0], p[1], p[2], 255))
+            elif colour == 3:
+                alpha = trns[p[0]] if trns is not None and p[0] < len(trns) else 255
+                pixels.append(palette[p[0]] + (alpha,))
+            elif colour == 4:
+                pixels.append((p[0], p[0], p[0], p[1]))
+            else:
+                pixels.append(tuple(p))
+        rows.append(pixels)
+
+    return width, height, rows
+
+
+def pack(images):
+    """Shelf packing, tallest first. Returns {name: (x, y)} and the atlas height."""
+    order = sorted(images, key=lambda name: -images[name][1])
+    positions, x, y, shelf = {}, 0, 0, 0
+    for name in order:
+        w, h = images[name][0] + 2 * PADDING, images[name][1] + 2 * PADDING
+        if x + w > ATLAS_WIDTH:
+            x, y, shelf = 0, y + shelf, 0
+        positions[name] = (x + PADDING, y + PADDING)
+        x, shelf = x + w, max(shelf, h)
+    return positions, y + shelf
+
+
+def main():
+    images = {name: decode_png(os.path.join(SOURCE, file)) for name, file in ASSETS}
+    positions, height = pack(images)
+
+    pixels = bytearray(ATLAS_WIDTH * height * 4)
+    for name, (width, image_height, rows) in images.items():
+        px, py = positions[name]
+        for y in range(image_height):
+            offset = ((py + y) * ATLAS_WIDTH + px) * 4
+            for r, g, b, a in rows[y]:
+                pixels[offset:offset + 4] = bytes(((b * a + 127) // 255, (g * a + 127) // 255, (r * a + 127) // 255, a))
+                offset += 4
+
+    with open(os.path.join(SOURCE, "atlas.bin"), "wb") as f:
+        f.write(MAGIC + struct.pack("<iii", VERSION, ATLAS_WIDTH, height))
+        f.write(zlib.compress(bytes(pixels), 6))
+
+    with open(os.path.join(SOURCE, "AtlasIndex.h"), "w") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by Tools/pack_atlas.py from the PNGs in Source/ - do not edit.\n")
+        f.write("namespace AtlasIndex {\n\n")
+        f.write("    struct Region { int x, y, width, height; };\n\n")
+        f.write("    constexpr int version = %d;\n" % VERSION)
+        f.write("    constexpr int width = %d;\n" % ATLAS_WIDTH)
+        f.write("    constexpr int height = %d;\n\n" % height)
+        for name, _ in ASSETS:
+            x, y = positions[name]
+            f.write("    constexpr Region %s {%d, %d, %d, %d};\n" % (name, x, y, images[name][0], images[name][1]))
+        f.write("}\n")
+
+
+if __name__ == "__main__":
+    main()